@@ -18,7 +18,7 @@ void AsfMissingActor::Reload()
         return;
     }
     // Remove child component objects from the sfObjectMap
-    objPtr->ForEachDescendant([](sfObject::SPtr childPtr)
+    sfUtils::VisitDescendants(objPtr, [](const sfObject::SPtr& childPtr)
     {
         if (childPtr->Type() != sfType::Component)
         {
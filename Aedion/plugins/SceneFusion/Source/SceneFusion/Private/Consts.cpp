@@ -25,6 +25,11 @@ const sfName sfProp::CreationMethod = "#creationMethod";
 const sfName sfProp::Visualize = "#visualize";
 const sfName sfProp::IsRoot = "#isRoot";
 const sfName sfProp::Flags = "#flags";
+const sfName sfProp::Record = "#record";
+const sfName sfProp::Fields = "#fields";
+const sfName sfProp::Types = "#types";
+const sfName sfProp::Version = "#version";
+const sfName sfProp::Template = "#template";
 
 const sfName sfType::Actor = "Actor";
 const sfName sfType::Avatar = "Avatar";
@@ -34,3 +39,5 @@ const sfName sfType::LevelProperties = "LevelProperties";
 const sfName sfType::Component = "Component";
 const sfName sfType::MeshBounds = "MeshBounds";
 const sfName sfType::GameMode = "GameMode";
+const sfName sfType::PropertySchema = "PropertySchema";
+const sfName sfType::PropertyTemplate = "PropertyTemplate";
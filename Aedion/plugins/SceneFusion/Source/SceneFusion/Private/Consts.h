@@ -33,6 +33,11 @@ public:
     static const sfName Flags;
     static const sfName DefaultGameMode;
     static const sfName HierarchicalLODSetup;
+    static const sfName Record;
+    static const sfName Fields;
+    static const sfName Types;
+    static const sfName Version;
+    static const sfName Template;
 };
 
 /**
@@ -49,4 +54,6 @@ public:
     static const sfName Component;
     static const sfName MeshBounds;
     static const sfName GameMode;
+    static const sfName PropertySchema;
+    static const sfName PropertyTemplate;
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "../sfObjectMap.h"
 #include "../sfUtils.h"
 #include "../sfLoader.h"
+#include "../sfConfig.h"
 #include "../UI/sfDetailsPanelManager.h"
 
 #include <Editor.h>
@@ -53,8 +54,12 @@ void sfActorManager::Initialize()
     m_onMoveStartHandle = GEditor->OnBeginObjectMovement().AddRaw(this, &sfActorManager::OnMoveStart);
     m_onMoveEndHandle = GEditor->OnEndObjectMovement().AddRaw(this, &sfActorManager::OnMoveEnd);
     m_onActorMovedHandle = GEditor->OnActorMoved().AddRaw(this, &sfActorManager::OnActorMoved);
+    m_onSelectionChangedHandle = USelection::SelectionChangedEvent.AddRaw(this, &sfActorManager::OnSelectionChanged);
+    m_onSelectObjectHandle = USelection::SelectObjectEvent.AddRaw(this, &sfActorManager::OnSelectionChanged);
     m_numSyncedActors = 0;
     m_movingActors = false;
+    m_selectionChanged = true;
+    m_selectionCount = 0;
     m_collectGarbage = false;
     m_bspRebuildDelay = -1.0f;
 }
@@ -70,6 +75,8 @@ void sfActorManager::CleanUp()
     GEditor->OnBeginObjectMovement().Remove(m_onMoveStartHandle);
     GEditor->OnEndObjectMovement().Remove(m_onMoveEndHandle);
     GEditor->OnActorMoved().Remove(m_onActorMovedHandle);
+    USelection::SelectionChangedEvent.Remove(m_onSelectionChangedHandle);
+    USelection::SelectObjectEvent.Remove(m_onSelectObjectHandle);
 
     UWorld* world = GEditor->GetEditorWorldContext().World();
     for (TActorIterator<AActor> iter(world); iter; ++iter)
@@ -87,6 +94,9 @@ void sfActorManager::CleanUp()
     m_syncParentList.Empty();
     m_foldersToCheck.Empty();
     m_selectedActors.clear();
+    m_lockRequests.clear();
+    m_lockReleases.clear();
+    m_lockStateChanges.Empty();
     m_movedActors.Empty();
 }
 
@@ -99,8 +109,12 @@ void sfActorManager::Tick(float deltaTime)
         m_uploadList.Empty();
     }
 
+    // Apply lock state changes from the server
+    ApplyLockStateChanges();
+
     // Check for selection changes and request locks/unlocks
     UpdateSelection();
+    FlushLockRequests();
 
     // Send actor transform changes for moved actors
     for (AActor* actorPtr : m_movedActors)
@@ -154,20 +168,32 @@ void sfActorManager::Tick(float deltaTime)
 
 void sfActorManager::UpdateSelection()
 {
-    TSet<AActor*> selectedActors = sfDetailsPanelManager::Get().GetSelectedActors();
-    // Unreal doesn't have deselect events and doesn't fire select events when selecting through the World Outliner so
-    // we have to iterate the selection to check for changes
-    for (auto iter = m_selectedActors.cbegin(); iter != m_selectedActors.cend();)
+    for (const auto& pair : m_selectedActors)
     {
         if (m_movingActors)
         {
-            SyncComponentTransforms(iter->first);
-            m_movedActors.Remove(iter->first);
+            SyncComponentTransforms(pair.first);
+            m_movedActors.Remove(pair.first);
         }
-        SceneFusion::ComponentManager->SyncComponents(iter->first, iter->second);
+        SceneFusion::ComponentManager->SyncComponents(pair.first, pair.second);
+    }
+
+    // Selecting through the World Outliner and changing locked details panels do not always fire selection events, so
+    // also check if the number of selected actors changed.
+    int selectionCount = sfDetailsPanelManager::Get().GetSelectedActorCount();
+    if (!m_selectionChanged && selectionCount == m_selectionCount)
+    {
+        return;
+    }
+    m_selectionChanged = false;
+    m_selectionCount = selectionCount;
+
+    TSet<AActor*> selectedActors = sfDetailsPanelManager::Get().GetSelectedActors();
+    for (auto iter = m_selectedActors.cbegin(); iter != m_selectedActors.cend();)
+    {
         if (!selectedActors.Contains(iter->first))
         {
-            iter->second->ReleaseLock();
+            ReleaseLock(iter->second);
             m_selectedActors.erase(iter++);
         }
         else
@@ -185,7 +211,7 @@ void sfActorManager::UpdateSelection()
         sfObject::SPtr objPtr = sfObjectMap::GetSFObject(actorPtr);
         if (objPtr != nullptr && objPtr->IsSyncing())
         {
-            objPtr->RequestLock();
+            RequestLock(objPtr);
             m_selectedActors[actorPtr] = objPtr;
             if (m_movingActors)
             {
@@ -195,6 +221,94 @@ void sfActorManager::UpdateSelection()
     }
 }
 
+void sfActorManager::RequestLock(sfObject::SPtr objPtr)
+{
+    if (m_lockReleases.erase(objPtr) == 0)
+    {
+        m_lockRequests.insert(objPtr);
+    }
+}
+
+void sfActorManager::ReleaseLock(sfObject::SPtr objPtr)
+{
+    if (m_lockRequests.erase(objPtr) == 0)
+    {
+        m_lockReleases.insert(objPtr);
+    }
+}
+
+void sfActorManager::FlushLockRequests()
+{
+    for (const sfObject::SPtr& objPtr : m_lockReleases)
+    {
+        objPtr->ReleaseLock();
+    }
+    for (const sfObject::SPtr& objPtr : m_lockRequests)
+    {
+        objPtr->RequestLock();
+    }
+    m_lockReleases.clear();
+    m_lockRequests.clear();
+}
+
+void sfActorManager::QueueLockStateChange(sfObject::SPtr objPtr, bool ownerChanged)
+{
+    AActor* actorPtr = sfObjectMap::Get<AActor>(objPtr);
+    if (actorPtr == nullptr)
+    {
+        return;
+    }
+    LockStateChange& change = m_lockStateChanges.FindOrAdd(actorPtr);
+    change.ObjectPtr = objPtr;
+    change.OwnerChanged |= ownerChanged;
+}
+
+void sfActorManager::ApplyLockStateChanges()
+{
+    if (m_lockStateChanges.Num() == 0)
+    {
+        return;
+    }
+    bool reselected = false;
+    for (const TPair<AActor*, LockStateChange>& pair : m_lockStateChanges)
+    {
+        sfObject::SPtr objPtr = pair.Value.ObjectPtr;
+        // Look up the actor again in case it was replaced since the change was queued
+        AActor* actorPtr = sfObjectMap::Get<AActor>(objPtr);
+        if (actorPtr == nullptr)
+        {
+            continue;
+        }
+        if (objPtr->IsLocked())
+        {
+            Lock(actorPtr, objPtr);
+            UMaterialInterface* lockMaterialPtr = pair.Value.OwnerChanged ?
+                SceneFusion::GetLockMaterial(objPtr->LockOwner()) : nullptr;
+            if (lockMaterialPtr != nullptr)
+            {
+                TArray<UsfLockComponent*> locks;
+                sfActorUtil::GetSceneComponents<UsfLockComponent>(actorPtr, locks);
+                for (UsfLockComponent* lockPtr : locks)
+                {
+                    lockPtr->SetMaterial(lockMaterialPtr);
+                }
+            }
+        }
+        else
+        {
+            // Reselecting notifies the editor, which rebuilds the details panel, so notify once after the loop
+            reselected |= actorPtr->IsSelected();
+            Unlock(actorPtr, false);
+        }
+        InvokeOnLockStateChange(objPtr, actorPtr);
+    }
+    m_lockStateChanges.Empty();
+    if (reselected)
+    {
+        GEditor->NoteSelectionChange();
+    }
+}
+
 void sfActorManager::DestroyActor(AActor* actorPtr)
 {
     if (actorPtr->IsA<ABrush>())
@@ -343,6 +457,30 @@ void sfActorManager::OnActorAdded(AActor* actorPtr)
 
 void sfActorManager::UploadActors(const TArray<AActor*>& actors)
 {
+    // Values shared by actors and components of the same class are sent once in templates.
+    bool useTemplates = sfConfig::Get().SchemaRecords && actors.Num() > 1;
+    sfPropertyUtil::TemplateStats oldStats = sfPropertyUtil::GetTemplateStats();
+    if (useTemplates)
+    {
+        TArray<UObject*> uobjects;
+        for (AActor* actorPtr : actors)
+        {
+            if (!IsSyncable(actorPtr))
+            {
+                continue;
+            }
+            uobjects.Add(actorPtr);
+            for (UActorComponent* componentPtr : actorPtr->GetComponents())
+            {
+                if (SceneFusion::ComponentManager->IsSyncable(componentPtr))
+                {
+                    uobjects.Add(componentPtr);
+                }
+            }
+        }
+        sfPropertyUtil::CreateTemplates(uobjects);
+    }
+
     std::list<sfObject::SPtr> objects;
     sfObject::SPtr parentPtr = nullptr;
     sfObject::SPtr currentParentPtr = nullptr;
@@ -410,6 +548,21 @@ void sfActorManager::UploadActors(const TArray<AActor*>& actors)
         // Pre-existing child objects can only be attached after calling Create.
         FindAndAttachChildren(objects);
     }
+
+    if (useTemplates)
+    {
+        sfPropertyUtil::ClearTemplates();
+        const sfPropertyUtil::TemplateStats& stats = sfPropertyUtil::GetTemplateStats();
+        int values = stats.Values - oldStats.Values;
+        int sentValues = stats.SentValues - oldStats.SentValues;
+        if (values > 0)
+        {
+            KS::Log::Debug("Uploaded " + std::to_string(actors.Num()) + " actor(s) with " +
+                std::to_string(stats.Templates - oldStats.Templates) + " template(s). Sent " +
+                std::to_string(sentValues) + " of " + std::to_string(values) + " recorded values (dedupe ratio " +
+                std::to_string((float)values / FMath::Max(sentValues, 1)) + ").", LOG_CHANNEL);
+        }
+    }
 }
 
 void sfActorManager::FindAndAttachChildren(const std::list<sfObject::SPtr>& objects)
@@ -465,7 +618,7 @@ sfObject::SPtr sfActorManager::CreateObject(AActor* actorPtr)
 
     if (actorPtr->IsSelected())
     {
-        objPtr->RequestLock();
+        RequestLock(objPtr);
         m_selectedActors[actorPtr] = objPtr;
     }
 
@@ -482,11 +635,11 @@ sfObject::SPtr sfActorManager::CreateObject(AActor* actorPtr)
         className = sfUtils::ClassToFString(actorPtr->GetClass());
     }
 
-    propertiesPtr->Set(sfProp::Name, sfPropertyUtil::FromString(actorPtr->GetName()));
+    propertiesPtr->Set(sfProp::Name, sfPropertyUtil::FromName(actorPtr->GetFName()));
     propertiesPtr->Set(sfProp::Class, sfPropertyUtil::FromString(className));
     propertiesPtr->Set(sfProp::Label, sfPropertyUtil::FromString(actorPtr->GetActorLabel()));
-    propertiesPtr->Set(sfProp::Folder, sfPropertyUtil::FromString(actorPtr->GetFolderPath().ToString()));
-    sfPropertyUtil::CreateProperties(actorPtr, propertiesPtr);
+    propertiesPtr->Set(sfProp::Folder, sfPropertyUtil::FromName(actorPtr->GetFolderPath()));
+    sfPropertyUtil::CreateProperties(actorPtr, propertiesPtr, nullptr, sfConfig::Get().SchemaRecords);
 
     USceneComponent* rootComponentPtr = actorPtr->GetRootComponent();
     if (rootComponentPtr != nullptr)
@@ -543,7 +696,15 @@ void sfActorManager::OnCreate(sfObject::SPtr objPtr, int childIndex)
     {
         return;
     }
+    // Actors received while subscribing to a level's children are created one at a time, so their assets are
+    // prefetched here. Actors in levels that were received with their children were prefetched with the level.
+    if (objPtr->Parent() == levelObjectPtr && !m_levelManagerPtr->IsLevelObjectInitialized(levelPtr))
+    {
+        sfLoader::Get().Prefetch(objPtr);
+    }
+    double startTime = FPlatformTime::Seconds();
     AActor* actorPtr = InitializeActor(objPtr, levelPtr);
+    sfLoader::Get().GetJoinStats().Apply += FPlatformTime::Seconds() - startTime;
     if (actorPtr == nullptr)
     {
         return;
@@ -619,7 +780,7 @@ AActor* sfActorManager::InitializeActor(sfObject::SPtr objPtr, ULevel* levelPtr)
         EnableParentChangeHandler();
         if (actorPtr->IsSelected())
         {
-            objPtr->RequestLock();
+            RequestLock(objPtr);
             m_selectedActors[actorPtr] = objPtr;
         }
         if (actorPtr->IsA<ABrush>())
@@ -706,8 +867,13 @@ void sfActorManager::OnActorDeleted(AActor* actorPtr)
             m_sessionPtr->Delete(objPtr);
         }
     }
+    if (objPtr != nullptr)
+    {
+        m_lockRequests.erase(objPtr);
+    }
     m_uploadList.Remove(actorPtr);
     m_selectedActors.erase(actorPtr);
+    m_lockStateChanges.Remove(actorPtr);
     if (m_selectedActors.size() == 0)
     {
         m_movingActors = false;
@@ -718,9 +884,11 @@ void sfActorManager::OnActorDeleted(AActor* actorPtr)
 void sfActorManager::CleanUpChildrenOfDeletedObject(sfObject::SPtr objPtr, sfObject::SPtr levelObjPtr,
     bool recurseChildActors)
 {
-    for (int i = objPtr->Children().size() - 1; i >= 0; i--)
+    // Copy the children in reverse order since children can be moved to the level object. Indexing the child list is
+    // linear, so do not call Child(i) in the loop.
+    std::vector<sfObject::SPtr> children(objPtr->Children().rbegin(), objPtr->Children().rend());
+    for (const sfObject::SPtr& childPtr : children)
     {
-        sfObject::SPtr childPtr = objPtr->Child(i);
         if (childPtr->Type() == sfType::Actor)
         {
             AActor* childActorPtr = sfObjectMap::Get<AActor>(childPtr);
@@ -781,8 +949,7 @@ void sfActorManager::OnLock(sfObject::SPtr objPtr)
         OnCreate(objPtr, 0);
         return;
     }
-    InvokeOnLockStateChange(objPtr, actorPtr);
-    Lock(actorPtr, objPtr);
+    QueueLockStateChange(objPtr, false);
 }
 
 void sfActorManager::Lock(AActor* actorPtr, sfObject::SPtr objPtr)
@@ -820,15 +987,10 @@ void sfActorManager::Lock(AActor* actorPtr, sfObject::SPtr objPtr)
 
 void sfActorManager::OnUnlock(sfObject::SPtr objPtr)
 {
-    AActor* actorPtr = sfObjectMap::Get<AActor>(objPtr);
-    if (actorPtr != nullptr)
-    {
-        Unlock(actorPtr);
-        InvokeOnLockStateChange(objPtr, actorPtr);
-    }
+    QueueLockStateChange(objPtr, false);
 }
 
-void sfActorManager::Unlock(AActor* actorPtr)
+void sfActorManager::Unlock(AActor* actorPtr, bool notify)
 {
     // If you undo the deletion of an actor with lock components, the lock components will not be part of the
     // OwnedComponents set so we have to use our own function to find them instead of AActor->GetComponents.
@@ -849,30 +1011,12 @@ void sfActorManager::Unlock(AActor* actorPtr)
         SceneFusion::RedrawActiveViewport();
     }
     // When a selected actor becomes unlocked you have to unselect and reselect it to unlock the handles
-    sfActorUtil::Reselect(actorPtr);
+    sfActorUtil::Reselect(actorPtr, notify);
 }
 
 void sfActorManager::OnLockOwnerChange(sfObject::SPtr objPtr)
 {
-    AActor* actorPtr = sfObjectMap::Get<AActor>(objPtr);
-    if (actorPtr == nullptr)
-    {
-        return;
-    }
-
-    InvokeOnLockStateChange(objPtr, actorPtr);
-
-    UMaterialInterface* lockMaterialPtr = SceneFusion::GetLockMaterial(objPtr->LockOwner());
-    if (lockMaterialPtr == nullptr)
-    {
-        return;
-    }
-    TArray<UsfLockComponent*> locks;
-    sfActorUtil::GetSceneComponents<UsfLockComponent>(actorPtr, locks);
-    for (UsfLockComponent* lockPtr : locks)
-    {
-        lockPtr->SetMaterial(lockMaterialPtr);
-    }
+    QueueLockStateChange(objPtr, true);
 }
 
 void sfActorManager::OnAttachDetach(AActor* actorPtr, const AActor* parentPtr)
@@ -933,7 +1077,7 @@ void sfActorManager::OnFolderChange(const AActor* actorPtr, FName oldFolder)
     else
     {
         propertiesPtr->Set(sfProp::Folder,
-            sfPropertyUtil::FromString(actorPtr->GetFolderPath().ToString()));
+            sfPropertyUtil::FromName(actorPtr->GetFolderPath()));
     }
 }
 
@@ -952,6 +1096,11 @@ void sfActorManager::OnMoveEnd(UObject& obj)
     }
 }
 
+void sfActorManager::OnSelectionChanged(UObject* objPtr)
+{
+    m_selectionChanged = true;
+}
+
 void sfActorManager::OnActorMoved(AActor* actorPtr)
 {
     if (sfPropertyUtil::ListeningForPropertyChanges() &&
@@ -1216,18 +1365,21 @@ void sfActorManager::OnRemoveLevel(sfObject::SPtr levelObjPtr, ULevel* levelPtr)
 {
     if (levelObjPtr != nullptr)
     {
-        levelObjPtr->ForEachDescendant([this](sfObject::SPtr objPtr)
+        // Use the level's partition of the object map instead of walking the level's sfObject hierarchy
+        sfObjectMap::ForEachInLevel(levelPtr, [this](const sfObject::SPtr& objPtr, UObject* uobjPtr)
         {
-            UObject* uobjPtr = sfObjectMap::Remove(objPtr);
             AActor* actorPtr = Cast<AActor>(uobjPtr);
             if (actorPtr != nullptr)
             {
                 m_numSyncedActors--;
                 m_selectedActors.erase(actorPtr);
                 m_movedActors.Remove(actorPtr);
+                m_lockStateChanges.Remove(actorPtr);
+                m_lockRequests.erase(objPtr);
+                m_lockReleases.erase(objPtr);
             }
-            return true;
         });
+        sfObjectMap::RemoveLevel(levelPtr);
     }
 
     for (int i = m_uploadList.Num() - 1; i >= 0; i--)
@@ -1241,6 +1393,8 @@ void sfActorManager::OnRemoveLevel(sfObject::SPtr levelObjPtr, ULevel* levelPtr)
 
 void sfActorManager::OnSFLevelObjectCreate(sfObject::SPtr sfLevelObjPtr, ULevel* levelPtr)
 {
+    // Start loading the assets for the whole level before spawning any actors
+    sfLoader::Get().Prefetch(sfLevelObjPtr);
     for (sfObject::SPtr childPtr : sfLevelObjPtr->Children())
     {
         if (childPtr->Type() == sfType::Actor)
@@ -99,6 +99,16 @@ public:
     int NumSyncedActors();
 
 private:
+    /**
+     * A lock state change received from the server that has not been applied yet.
+     */
+    struct LockStateChange
+    {
+    public:
+        sfObject::SPtr ObjectPtr;
+        bool OwnerChanged = false;
+    };
+
     FDelegateHandle m_onActorAddedHandle;
     FDelegateHandle m_onActorDeletedHandle;
     FDelegateHandle m_onActorAttachedHandle;
@@ -108,6 +118,8 @@ private:
     FDelegateHandle m_onMoveStartHandle;
     FDelegateHandle m_onMoveEndHandle;
     FDelegateHandle m_onActorMovedHandle;
+    FDelegateHandle m_onSelectionChangedHandle;
+    FDelegateHandle m_onSelectObjectHandle;
 
     TArray<AActor*> m_uploadList;
     TQueue<sfObject::SPtr> m_recreateQueue;
@@ -117,9 +129,16 @@ private:
 
     // Use std map because TSortedMap causes compile errors in Unreal's code
     std::map<AActor*, sfObject::SPtr> m_selectedActors;
+    // Lock requests and releases are sent together at the end of the tick. Queuing a release cancels a queued request
+    // for the same object and vice versa.
+    std::unordered_set<sfObject::SPtr> m_lockRequests;
+    std::unordered_set<sfObject::SPtr> m_lockReleases;
+    TMap<AActor*, LockStateChange> m_lockStateChanges;
     sfSession::SPtr m_sessionPtr;
     int m_numSyncedActors;
     bool m_movingActors;
+    bool m_selectionChanged;
+    int m_selectionCount;
     TSet<AActor*> m_movedActors;
     bool m_collectGarbage;
     float m_bspRebuildDelay;
@@ -127,10 +146,44 @@ private:
     TSharedPtr<sfLevelManager> m_levelManagerPtr;
 
     /**
-     * Checks for selection changes and requests locks on newly selected objects and unlocks unselected objects.
+     * Syncs components of selected actors. If the selection changed, requests locks on newly selected objects and
+     * unlocks unselected objects.
      */
     void UpdateSelection();
 
+    /**
+     * Queues a lock request for an object. Queued requests are sent by FlushLockRequests.
+     *
+     * @param   sfObject::SPtr objPtr to lock.
+     */
+    void RequestLock(sfObject::SPtr objPtr);
+
+    /**
+     * Queues a lock release for an object. Queued releases are sent by FlushLockRequests.
+     *
+     * @param   sfObject::SPtr objPtr to unlock.
+     */
+    void ReleaseLock(sfObject::SPtr objPtr);
+
+    /**
+     * Sends queued lock requests and releases in one pass.
+     */
+    void FlushLockRequests();
+
+    /**
+     * Queues a lock state change from the server to be applied by ApplyLockStateChanges.
+     *
+     * @param   sfObject::SPtr objPtr whose lock state changed.
+     * @param   bool ownerChanged - true if the lock owner changed.
+     */
+    void QueueLockStateChange(sfObject::SPtr objPtr, bool ownerChanged);
+
+    /**
+     * Applies queued lock state changes in one pass. Each actor's lock components are updated once for its final
+     * lock state, and the editor is notified of selection changes once.
+     */
+    void ApplyLockStateChanges();
+
     /**
      * Destroys an actor.
      *
@@ -246,6 +299,14 @@ private:
      */
     void OnMoveEnd(UObject& obj);
 
+    /**
+     * Called when the editor selection changes or an object is selected or deselected. Marks the selection as changed
+     * so it is checked on the next tick.
+     *
+     * @param   UObject* objPtr - selection set or object whose selection changed.
+     */
+    void OnSelectionChanged(UObject* objPtr);
+
     /**
      * Called when an actor moves.
      *
@@ -344,8 +405,10 @@ private:
      * Unlocks an actor.
      *
      * @param   AActor* actorPtr
+     * @param   bool notify - if false and the actor is selected, the editor is not notified when the actor is
+     *          reselected.
      */
-    void Unlock(AActor* actorPtr);
+    void Unlock(AActor* actorPtr, bool notify = true);
 
     /**
      * Called when an actor is created by another user.
@@ -1,5 +1,6 @@
 #include "sfAvatarManager.h"
 #include "../sfPropertyUtil.h"
+#include "../sfTransformCodec.h"
 #include "../SceneFusion.h"
 #include "../Consts.h"
 #include "../Actors/sfBodyActor.h"
@@ -139,8 +140,8 @@ sfDictionaryProperty::SPtr sfAvatarManager::CreateAvatarProperty(
 {
     sfDictionaryProperty::SPtr propertiesPtr = sfDictionaryProperty::Create();
     propertiesPtr->Set(sfProp::Mesh, sfValueProperty::Create(meshId));
-    propertiesPtr->Set(sfProp::Location, sfPropertyUtil::FromVector(location));
-    propertiesPtr->Set(sfProp::Rotation, sfPropertyUtil::FromQuat(rotation));
+    propertiesPtr->Set(sfProp::Location, sfTransformCodec::FromLocation(location));
+    propertiesPtr->Set(sfProp::Rotation, sfTransformCodec::FromQuat(rotation));
     return propertiesPtr;
 }
 
@@ -222,7 +223,7 @@ void sfAvatarManager::RegisterPropertyChangeHandlers()
         AsfAvatarActor* actorPtr = m_sfObjToActor.FindRef(propertyPtr->GetContainerObject()->Id());
         if (IsActorValid(actorPtr))
         {
-            actorPtr->SetActorLocation(sfPropertyUtil::ToVector(propertyPtr));
+            actorPtr->SetActorLocation(sfTransformCodec::ToLocation(propertyPtr));
             if (m_followingCameraPtr == actorPtr)
             {
                 StartFollowing();
@@ -235,7 +236,7 @@ void sfAvatarManager::RegisterPropertyChangeHandlers()
         AsfAvatarActor* actorPtr = m_sfObjToActor.FindRef(propertyPtr->GetContainerObject()->Id());
         if (IsActorValid(actorPtr))
         {
-            actorPtr->SetRotation(sfPropertyUtil::ToQuat(propertyPtr));
+            actorPtr->SetRotation(sfTransformCodec::ToQuat(propertyPtr));
             if (m_followingCameraPtr == actorPtr)
             {
                 StartFollowing();
@@ -284,8 +285,8 @@ void sfAvatarManager::OnCreate(sfObject::SPtr objPtr, int childIndex)
         if (meshId == HEAD)
         {
             actorPtr = AsfBodyActor::Create(
-                sfPropertyUtil::ToVector(propertiesPtr->Get(sfProp::Location)),
-                sfPropertyUtil::ToQuat(propertiesPtr->Get(sfProp::Rotation)).Rotator(),
+                sfTransformCodec::ToLocation(propertiesPtr->Get(sfProp::Location)),
+                sfTransformCodec::ToQuat(propertiesPtr->Get(sfProp::Rotation)).Rotator(),
                 m_meshPtrs[HEAD],
                 m_meshPtrs[HMD],
                 m_meshPtrs[BODY],
@@ -294,8 +295,8 @@ void sfAvatarManager::OnCreate(sfObject::SPtr objPtr, int childIndex)
         else
         {
             actorPtr = AsfAvatarActor::Create(
-                sfPropertyUtil::ToVector(propertiesPtr->Get(sfProp::Location)),
-                sfPropertyUtil::ToQuat(propertiesPtr->Get(sfProp::Rotation)).Rotator(),
+                sfTransformCodec::ToLocation(propertiesPtr->Get(sfProp::Location)),
+                sfTransformCodec::ToQuat(propertiesPtr->Get(sfProp::Rotation)).Rotator(),
                 m_meshPtrs[meshId],
                 m_userIdToMaterial[userId]);
         }
@@ -602,15 +603,17 @@ void sfAvatarManager::SendTransform(
     const FVector& location,
     const FQuat& rotation)
 {
-
-    if (sfPropertyUtil::ToVector(propertiesPtr->Get(sfProp::Location)) != location)
+    // Compare encoded values so quantized transforms are only sent when the quantized value changes
+    sfValueProperty::SPtr locationPtr = sfTransformCodec::FromLocation(location);
+    if (!locationPtr->Equals(propertiesPtr->Get(sfProp::Location)))
     {
-        propertiesPtr->Set(sfProp::Location, sfPropertyUtil::FromVector(location));
+        propertiesPtr->Set(sfProp::Location, locationPtr);
     }
 
-    if (sfPropertyUtil::ToQuat(propertiesPtr->Get(sfProp::Rotation)) != rotation)
+    sfValueProperty::SPtr rotationPtr = sfTransformCodec::FromQuat(rotation);
+    if (!rotationPtr->Equals(propertiesPtr->Get(sfProp::Rotation)))
     {
-        propertiesPtr->Set(sfProp::Rotation, sfPropertyUtil::FromQuat(rotation));
+        propertiesPtr->Set(sfProp::Rotation, rotationPtr);
     }
 }
 
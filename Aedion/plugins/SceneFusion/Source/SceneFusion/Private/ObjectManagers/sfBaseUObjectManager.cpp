@@ -72,7 +72,7 @@ void sfBaseUObjectManager::OnRemoveField(sfDictionaryProperty::SPtr dictPtr, con
     UProperty* upropPtr = uobjPtr->GetClass()->FindPropertyByName(FName(UTF8_TO_TCHAR(name->c_str())));
     if (upropPtr != nullptr)
     {
-        sfPropertyUtil::SetToDefaultValue(uobjPtr, upropPtr);
+        sfPropertyUtil::SetToRecordValue(uobjPtr, upropPtr, dictPtr);
     }
 }
 
@@ -106,6 +106,16 @@ bool sfBaseUObjectManager::ArrayInsert(
         return false;
     }
     FScriptArrayHelper array(arrayPropPtr, upropInstance.Data());
+    if (sfPropertyUtil::IsPackedList(arrayPropPtr->Inner, listPtr))
+    {
+        if (!sfPropertyUtil::InsertPackedSlices(arrayPropPtr, array, listPtr, index, count))
+        {
+            // The slices don't line up with the array. Set the whole array from the slice list.
+            sfPropertyUtil::SetPackedArray(arrayPropPtr, array, listPtr);
+        }
+        sfPropertyUtil::MarkPropertyChanged(uobjPtr, upropInstance.Property(), listPtr);
+        return true;
+    }
     array.InsertValues(index, count);
     for (int i = index; i < index + count; i++)
     {
@@ -156,6 +166,7 @@ bool sfBaseUObjectManager::SetInsert(
         }
     }
     sfPropertyUtil::MarkHashStale(upropInstance);
+    sfPropertyUtil::InvalidateSparseIndexes(upropInstance.Data());
     return true;
 }
 
@@ -203,6 +214,7 @@ bool sfBaseUObjectManager::MapInsert(
         }
     }
     sfPropertyUtil::MarkHashStale(upropInstance);
+    sfPropertyUtil::InvalidateSparseIndexes(upropInstance.Data());
     return true;
 }
 
@@ -218,12 +230,16 @@ void sfBaseUObjectManager::OnListRemove(sfListProperty::SPtr listPtr, int index,
     {
         return;
     }
-    ArrayRemove(upropInstance, index, count) || SetRemove(upropInstance, index, count) ||
+    ArrayRemove(upropInstance, listPtr, index, count) || SetRemove(upropInstance, index, count) ||
         MapRemove(upropInstance, index, count);
     sfPropertyUtil::MarkPropertyChanged(uobjPtr, upropInstance.Property(), listPtr);
 }
 
-bool sfBaseUObjectManager::ArrayRemove(const sfUPropertyInstance& upropInstance, int index, int count)
+bool sfBaseUObjectManager::ArrayRemove(
+    const sfUPropertyInstance& upropInstance,
+    sfListProperty::SPtr listPtr,
+    int index,
+    int count)
 {
     UArrayProperty* arrayPropPtr = Cast<UArrayProperty>(upropInstance.Property());
     if (arrayPropPtr == nullptr)
@@ -231,6 +247,20 @@ bool sfBaseUObjectManager::ArrayRemove(const sfUPropertyInstance& upropInstance,
         return false;
     }
     FScriptArrayHelper array(arrayPropPtr, upropInstance.Data());
+    if (listPtr->Size() == 0)
+    {
+        array.EmptyValues();
+        return true;
+    }
+    if (sfPropertyUtil::IsPackedList(arrayPropPtr->Inner, listPtr))
+    {
+        if (!sfPropertyUtil::RemovePackedSlices(arrayPropPtr, array, listPtr, index, count))
+        {
+            // The slices don't line up with the array. Set the whole array from the slice list.
+            sfPropertyUtil::SetPackedArray(arrayPropPtr, array, listPtr);
+        }
+        return true;
+    }
     array.RemoveValues(index, count);
     return true;
 }
@@ -243,19 +273,12 @@ bool sfBaseUObjectManager::SetRemove(const sfUPropertyInstance& upropInstance, i
         return false;
     }
     FScriptSetHelper set(setPropPtr, upropInstance.Data());
-    int i = 0;
-    for (; i < set.GetMaxIndex(); i++)
+    int sparseIndex = sfPropertyUtil::GetSparseIndex(set, index);
+    if (sparseIndex >= 0)
     {
-        if (set.IsValidIndex(i))
-        {
-            index--;
-            if (index < 0)
-            {
-                break;
-            }
-        }
+        set.RemoveAt(sparseIndex, count);
+        sfPropertyUtil::InvalidateSparseIndexes(upropInstance.Data());
     }
-    set.RemoveAt(i, count);
     return true;
 }
 
@@ -267,19 +290,12 @@ bool sfBaseUObjectManager::MapRemove(const sfUPropertyInstance& upropInstance, i
         return false;
     }
     FScriptMapHelper map(mapPropPtr, upropInstance.Data());
-    int i = 0;
-    for (; i < map.GetMaxIndex(); i++)
+    int sparseIndex = sfPropertyUtil::GetSparseIndex(map, index);
+    if (sparseIndex >= 0)
     {
-        if (map.IsValidIndex(i))
-        {
-            index--;
-            if (index < 0)
-            {
-                break;
-            }
-        }
+        map.RemoveAt(sparseIndex, count);
+        sfPropertyUtil::InvalidateSparseIndexes(upropInstance.Data());
     }
-    map.RemoveAt(i, count);
     return true;
 }
 
@@ -24,7 +24,7 @@ protected:
 
     /**
      * Tries to insert elements from an sfListProperty into an array using reflection. Returns false if the UProperty
-     * is not an array property.
+     * is not an array property. If the list is a packed array, inserts the elements in the inserted slices.
      *
      * @param   UObject* uobjPtr the property belongs to.
      * @param   const sfUPropertyInstance& upropInstance to try inserting array elements for. Returns false if this is
@@ -43,15 +43,16 @@ protected:
 
     /**
      * Tries to remove elements from an array using reflection. Returns false if the UProperty is not an array
-     * property.
+     * property. If the list is a packed array, removes the elements that were in the removed slices.
      *
      * @param   const sfUPropertyInstance& upropInstance to try removing array elements from. Returns false if this is
      *          not an array property.
+     * @param   sfListProperty::SPtr listPtr the elements were removed from.
      * @param   int index of first element to remove.
      * @param   int count - number of elements to remove.
      * @return  bool true if the UProperty was an array property.
      */
-    bool ArrayRemove(const sfUPropertyInstance& upropInstance, int index, int count);
+    bool ArrayRemove(const sfUPropertyInstance& upropInstance, sfListProperty::SPtr listPtr, int index, int count);
 
     /**
      * Tries to insert elements from an sfListProperty into a set using reflection. Returns false if the UProperty is
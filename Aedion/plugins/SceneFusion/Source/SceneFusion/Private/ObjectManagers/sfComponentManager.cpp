@@ -9,6 +9,7 @@
 #include "../Actors/sfMissingActor.h"
 #include "../sfActorUtil.h"
 #include "../sfUtils.h"
+#include "../sfConfig.h"
 #include <sfDictionaryProperty.h>
 #include <Editor.h>
 
@@ -104,7 +105,7 @@ void sfComponentManager::SyncComponents(AActor* actorPtr, sfObject::SPtr actorOb
             }
             else
             {
-                propertiesPtr->Set(sfProp::Name, sfPropertyUtil::FromString(componentPtr->GetName()));
+                propertiesPtr->Set(sfProp::Name, sfPropertyUtil::FromName(componentPtr->GetFName()));
             }
         }
     }
@@ -134,9 +135,11 @@ void sfComponentManager::RestoreDeletedComponents(sfObject::SPtr objPtr)
 
 void sfComponentManager::FindDeletedComponents(sfObject::SPtr objPtr)
 {
-    for (int i = objPtr->Children().size() - 1; i >= 0; i--)
+    // Copy the children in reverse order since they can be deleted or reparented. Indexing the child list is linear,
+    // so do not call Child(i) in the loop.
+    std::vector<sfObject::SPtr> children(objPtr->Children().rbegin(), objPtr->Children().rend());
+    for (const sfObject::SPtr& childPtr : children)
     {
-        sfObject::SPtr childPtr = objPtr->Child(i);
         if (childPtr->Type() != sfType::Component)
         {
             continue;
@@ -152,9 +155,9 @@ void sfComponentManager::FindDeletedComponents(sfObject::SPtr objPtr)
             }
             sfObjectMap::Remove(componentPtr);
             // Component children are already reparented, but actor children still need to be reparented.
-            for (int j = childPtr->Children().size() - 1; j >= 0; j--)
+            std::vector<sfObject::SPtr> grandChildren(childPtr->Children().rbegin(), childPtr->Children().rend());
+            for (const sfObject::SPtr& grandChildPtr : grandChildren)
             {
-                sfObject::SPtr grandChildPtr = childPtr->Child(j);
                 AActor* actorPtr = sfObjectMap::Get<AActor>(grandChildPtr);
                 if (actorPtr != nullptr && actorPtr->GetRootComponent() != nullptr)
                 {
@@ -370,7 +373,7 @@ sfObject::SPtr sfComponentManager::CreateObject(UActorComponent* componentPtr)
         className = sfUtils::ClassToFString(componentPtr->GetClass());
     }
 
-    propertiesPtr->Set(sfProp::Name, sfPropertyUtil::FromString(componentPtr->GetName()));
+    propertiesPtr->Set(sfProp::Name, sfPropertyUtil::FromName(componentPtr->GetFName()));
     propertiesPtr->Set(sfProp::Class, sfPropertyUtil::FromString(className));
 
     EComponentCreationMethod creationMethod = componentPtr->CreationMethod;
@@ -389,7 +392,7 @@ sfObject::SPtr sfComponentManager::CreateObject(UActorComponent* componentPtr)
         propertiesPtr->Set(sfProp::Flags, sfValueProperty::Create((uint32_t)flags));
     }
 
-    sfPropertyUtil::CreateProperties(componentPtr, propertiesPtr);
+    sfPropertyUtil::CreateProperties(componentPtr, propertiesPtr, nullptr, sfConfig::Get().SchemaRecords);
 
     USceneComponent* sceneComponentPtr = Cast<USceneComponent>(componentPtr);
     if (sceneComponentPtr == nullptr)
@@ -727,7 +727,7 @@ void sfLevelManager::UploadLevel(ULevel* levelPtr)
 
             // Set folder property
             levelPropertiesPtr->Set(sfProp::Folder,
-                sfPropertyUtil::FromString(streamingLevelPtr->GetFolderPath().ToString()));
+                sfPropertyUtil::FromName(streamingLevelPtr->GetFolderPath()));
 
             sfPropertyUtil::CreateProperties(streamingLevelPtr, levelPropertiesPtr, &PROPERTY_BLACKLIST);
             sfObjectMap::Add(propertyObjPtr, streamingLevelPtr);
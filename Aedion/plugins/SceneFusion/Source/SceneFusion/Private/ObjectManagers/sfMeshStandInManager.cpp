@@ -3,6 +3,7 @@
 #include "../Consts.h"
 #include "../sfPropertyUtil.h"
 #include "../sfLoader.h"
+#include "../sfStandInCache.h"
 
 #include <Engine/StaticMesh.h>
 #include <Developer/RawMesh/Public/RawMesh.h>
@@ -35,7 +36,7 @@ void sfMeshStandInManager::Generate(const FString& path, UObject* uobjPtr)
     {
         return;
     }
-    FBox bounds = GetBounds(SanitizePath(path));
+    FBox bounds = GetBounds(path);
     FRawMesh mesh;
     // Generate vertices
     mesh.VertexPositions.Add(FVector{ bounds.Min.X, bounds.Min.Y, bounds.Min.Z });
@@ -169,12 +170,20 @@ void sfMeshStandInManager::SendBounds(UObject* uobjPtr)
    }
 }
 
-FBox sfMeshStandInManager::GetBounds(const sfName& path)
+FBox sfMeshStandInManager::GetBounds(const FString& path)
 {
     sfProperty::SPtr propPtr;
-    if (m_meshBoundsPtr != nullptr && m_meshBoundsPtr->TryGet(path, propPtr))
+    FBox bounds;
+    if (m_meshBoundsPtr != nullptr && m_meshBoundsPtr->TryGet(SanitizePath(path), propPtr))
     {
-        return sfPropertyUtil::ToBox(propPtr);
+        bounds = sfPropertyUtil::ToBox(propPtr);
+        sfStandInCache::SetBounds(path, bounds);
+        return bounds;
+    }
+    // Use the bounds from the last time we were in this session if the mesh bounds object has not been received
+    if (sfStandInCache::TryGetBounds(path, bounds))
+    {
+        return bounds;
     }
     return FBox{ FVector{ -50.0f, -50.0f, -50.0f }, FVector{ 50.0f, 50.0f, 50.0f } };
 }
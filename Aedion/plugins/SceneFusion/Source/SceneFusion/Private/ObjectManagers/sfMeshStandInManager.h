@@ -61,12 +61,13 @@ private:
     void SendBounds(UObject* uobjPtr);
 
     /**
-     * Gets the bounding-box from server data for the mesh at the given path.
+     * Gets the bounding-box from server data for the mesh at the given path, or from the stand-in cache if the server
+     * has no data for the mesh.
      *
-     * @param   const sfName& path to mesh.
+     * @param   const FString& path to mesh.
      * @return  FBox bounds of the mesh.
      */
-    FBox GetBounds(const sfName& path);
+    FBox GetBounds(const FString& path);
 
     /**
      * Replaces characters in a mesh path that aren't permitted in property names with "//".
@@ -262,6 +262,8 @@ UMaterialInterface* SceneFusion::GetLockMaterial(sfUser::SPtr userPtr)
 
 void SceneFusion::OnObjectsReplaced(const TMap<UObject*, UObject*>& replacementMap)
 {
+    // Objects are replaced when blueprints are recompiled, which can change their class layouts
+    sfPropertyUtil::ClearSyncPlans();
     TSet<AActor*> actorPtrs;
     for (auto iter : replacementMap)
     {
@@ -298,6 +300,7 @@ void SceneFusion::OnObjectsReplaced(const TMap<UObject*, UObject*>& replacementM
 
 void SceneFusion::OnHotReload(bool automatic)
 {
+    sfPropertyUtil::ClearSyncPlans();
     for (UObject* uobjPtr : m_replacedObjects)
     {
         sfObject::SPtr objPtr = sfObjectMap::GetSFObject(uobjPtr);
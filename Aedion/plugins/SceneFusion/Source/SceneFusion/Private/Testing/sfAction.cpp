@@ -2,6 +2,13 @@
 #include "Log.h"
 #include "../sfUtils.h"
 #include "../SceneFusion.h"
+#include "../sfPropertyUtil.h"
+#include "../sfTransformCodec.h"
+#include "../sfConfig.h"
+#include "../sfLoader.h"
+#include "../sfObjectMap.h"
+#include "../Consts.h"
+#include "../UI/sfDetailsPanelManager.h"
 
 #include <Editor.h>
 #include <EditorLevelUtils.h>
@@ -11,6 +18,9 @@
 #include <EngineUtils.h>
 #include <PropertyEditorModule.h>
 #include <Widgets/Docking/SDockTab.h>
+#include <Engine/Selection.h>
+#include <Containers/Ticker.h>
+#include <unordered_map>
 
 #define LOG_CHANNEL "sfAction"
 
@@ -63,6 +73,641 @@ sfAction::sfAction()
             }
         }
     });
+
+    // Logs the property sync counters. Resets them if the first argument is "reset".
+    Register("PropertyStats", [](const TArray<FString>& args)
+    {
+        sfPropertyUtil::ContentHashStats& hashStats = sfPropertyUtil::GetContentHashStats();
+        int total = hashStats.Hits + hashStats.Misses;
+        KS::Log::Info("Skipped " + std::to_string(hashStats.Hits) + " of " + std::to_string(total) +
+            " properties because they were unchanged (" +
+            std::to_string(total > 0 ? hashStats.Hits * 100 / total : 0) + "%).", LOG_CHANNEL);
+        sfPropertyUtil::ListDiffStats& listStats = sfPropertyUtil::GetListDiffStats();
+        KS::Log::Info("Sent " + std::to_string(listStats.Operations) + " list operations with " +
+            std::to_string(listStats.Elements) + " elements.", LOG_CHANNEL);
+        sfPropertyUtil::ThrottleStats& throttleStats = sfPropertyUtil::GetThrottleStats();
+        KS::Log::Info("Sent " + std::to_string(throttleStats.Sent) + " local property changes and held back " +
+            std::to_string(throttleStats.Suppressed) + " interactive changes.", LOG_CHANNEL);
+        sfPropertyUtil::ChangeEventStats& eventStats = sfPropertyUtil::GetChangeEventStats();
+        KS::Log::Info("Broadcast " + std::to_string(eventStats.Events) + " change events and avoided " +
+            std::to_string(eventStats.ConstructionScriptRunsAvoided) + " construction script runs.", LOG_CHANNEL);
+        sfPropertyUtil::TemplateStats& templateStats = sfPropertyUtil::GetTemplateStats();
+        KS::Log::Info("Sent " + std::to_string(templateStats.SentValues) + " of " +
+            std::to_string(templateStats.Values) + " recorded values using " +
+            std::to_string(templateStats.Templates) + " templates.", LOG_CHANNEL);
+        if (args.Num() > 0 && args[0] == "reset")
+        {
+            hashStats = sfPropertyUtil::ContentHashStats();
+            listStats = sfPropertyUtil::ListDiffStats();
+            throttleStats = sfPropertyUtil::ThrottleStats();
+            eventStats = sfPropertyUtil::ChangeEventStats();
+            templateStats = sfPropertyUtil::TemplateStats();
+        }
+    });
+
+    // Logs the asset load queue depths, the delayed asset drain rate and the join timeline. Resets the drain rate and
+    // join timeline if the first argument is "reset".
+    Register("LoadStats", [](const TArray<FString>& args)
+    {
+        sfLoader::DelayedLoadStats& stats = sfLoader::Get().GetDelayedLoadStats();
+        KS::Log::Info(std::to_string(sfLoader::Get().GetDelayedQueueDepth()) + " objects waiting for idle and " +
+            std::to_string(sfLoader::Get().GetAsyncQueueDepth()) + " assets loading asynchronously.", LOG_CHANNEL);
+        KS::Log::Info("Loaded " + std::to_string(stats.Loaded) + " delayed asset properties in " +
+            std::to_string(stats.Seconds) + "s (" +
+            std::to_string(stats.Seconds > 0.0 ? stats.Loaded / stats.Seconds : 0.0) + " per second).", LOG_CHANNEL);
+        sfLoader::JoinStats& joinStats = sfLoader::Get().GetJoinStats();
+        KS::Log::Info("Join timeline: network " + std::to_string(joinStats.Network) + "s, I/O " +
+            std::to_string(joinStats.IO) + "s, apply " + std::to_string(joinStats.Apply) + "s, " +
+            std::to_string(joinStats.Assets) + " asset(s) prefetched.", LOG_CHANNEL);
+        if (args.Num() > 0 && args[0] == "reset")
+        {
+            stats = sfLoader::DelayedLoadStats();
+            joinStats = sfLoader::JoinStats();
+        }
+    });
+
+    // Times reading every syncable property on the selected actors and their components. Use actors with nested
+    // struct and array properties, such as splines and instanced meshes, to measure property conversion overhead.
+    Register("BenchmarkProperties", [](const TArray<FString>& args)
+    {
+        if (SceneFusion::Service->Session() == nullptr)
+        {
+            KS::Log::Warning("You must be in a session to benchmark properties.", LOG_CHANNEL);
+            return;
+        }
+        int iterations = args.Num() > 0 ? FCString::Atoi(*args[0]) : 100;
+        TArray<UObject*> uobjects;
+        for (FSelectionIterator iter(*GEditor->GetSelectedActors()); iter; ++iter)
+        {
+            AActor* actorPtr = Cast<AActor>(*iter);
+            if (actorPtr == nullptr)
+            {
+                continue;
+            }
+            uobjects.Add(actorPtr);
+            for (UActorComponent* componentPtr : actorPtr->GetComponents())
+            {
+                uobjects.Add(componentPtr);
+            }
+        }
+        if (uobjects.Num() == 0 || iterations <= 0)
+        {
+            KS::Log::Warning("Select at least one actor to benchmark.", LOG_CHANNEL);
+            return;
+        }
+        int numProperties = 0;
+        double startTime = FPlatformTime::Seconds();
+        for (int i = 0; i < iterations; i++)
+        {
+            for (UObject* uobjPtr : uobjects)
+            {
+                for (TFieldIterator<UProperty> iter(uobjPtr->GetClass()); iter; ++iter)
+                {
+                    if (sfPropertyUtil::IsSyncable(uobjPtr, *iter))
+                    {
+                        sfPropertyUtil::IsDefaultValue(uobjPtr, *iter);
+                        sfPropertyUtil::GetValue(uobjPtr, *iter);
+                        numProperties++;
+                    }
+                }
+            }
+        }
+        double milliseconds = (FPlatformTime::Seconds() - startTime) * 1000.0;
+        KS::Log::Info("Read " + std::to_string(numProperties) + " properties on " + std::to_string(uobjects.Num()) +
+            " objects in " + std::to_string(milliseconds) + "ms (" +
+            std::to_string(numProperties > 0 ? milliseconds * 1000.0 / numProperties : 0.0) + "us per property).",
+            LOG_CHANNEL);
+    });
+
+    // Compares the list operations sent by the old one-ahead list copy and the current list diff on synthetic edits to
+    // a list of vectors.
+    Register("BenchmarkListDiff", [](const TArray<FString>& args)
+    {
+        int size = args.Num() > 0 ? FCString::Atoi(*args[0]) : 5000;
+        if (size < 200)
+        {
+            KS::Log::Warning("List size must be at least 200.", LOG_CHANNEL);
+            return;
+        }
+        FRandomStream random(1234);
+        auto createElement = [&random]()
+        {
+            return sfPropertyUtil::FromVector(FVector(random.FRand(), random.FRand(), random.FRand()));
+        };
+
+        // The list copy algorithm used before the list diff. Detects single element inserts and removes by peeking
+        // one element ahead and otherwise overwrites elements.
+        auto legacyCopyList = [](sfListProperty::SPtr destPtr, sfListProperty::SPtr srcPtr, int& operations,
+            int& elements)
+        {
+            std::vector<sfProperty::SPtr> toAdd;
+            for (int i = 0; i < srcPtr->Size(); i++)
+            {
+                sfProperty::SPtr elementPtr = srcPtr->Get(i);
+                if (destPtr->Size() <= i)
+                {
+                    toAdd.push_back(elementPtr);
+                    continue;
+                }
+                if (elementPtr->Equals(destPtr->Get(i)))
+                {
+                    continue;
+                }
+                operations++;
+                if (destPtr->Size() > i + 1 && elementPtr->Equals(destPtr->Get(i + 1)))
+                {
+                    destPtr->Remove(i);
+                    continue;
+                }
+                elements++;
+                if (srcPtr->Size() > i + 1 && destPtr->Get(i)->Equals(srcPtr->Get(i + 1)))
+                {
+                    destPtr->Insert(i, elementPtr);
+                    i++;
+                    continue;
+                }
+                destPtr->Set(i, elementPtr);
+            }
+            if (toAdd.size() > 0)
+            {
+                destPtr->AddRange(toAdd);
+                operations++;
+                elements += (int)toAdd.size();
+            }
+            else if (destPtr->Size() > srcPtr->Size())
+            {
+                destPtr->Resize(srcPtr->Size());
+                operations++;
+            }
+        };
+
+        sfListProperty::SPtr basePtr = sfListProperty::Create();
+        for (int i = 0; i < size; i++)
+        {
+            basePtr->Add(createElement());
+        }
+        TArray<TPair<FString, sfListProperty::SPtr>> traces;
+
+        sfListProperty::SPtr editedPtr = basePtr->Clone()->AsList();
+        std::vector<sfProperty::SPtr> block;
+        for (int i = 0; i < 100; i++)
+        {
+            block.push_back(createElement());
+        }
+        editedPtr->InsertRange(size / 2, block);
+        traces.Emplace("Insert 100", editedPtr);
+
+        editedPtr = basePtr->Clone()->AsList();
+        editedPtr->RemoveRange(size / 2, 100);
+        traces.Emplace("Remove 100", editedPtr);
+
+        editedPtr = basePtr->Clone()->AsList();
+        block.clear();
+        for (int i = 100; i < 150; i++)
+        {
+            block.push_back(editedPtr->Get(i)->Clone());
+        }
+        editedPtr->RemoveRange(100, 50);
+        editedPtr->AddRange(block);
+        traces.Emplace("Move 50 to end", editedPtr);
+
+        editedPtr = basePtr->Clone()->AsList();
+        for (int i = 0; i < 10; i++)
+        {
+            editedPtr->Insert(random.RandRange(0, editedPtr->Size()), createElement());
+        }
+        traces.Emplace("10 scattered inserts", editedPtr);
+
+        editedPtr = basePtr->Clone()->AsList();
+        for (int i = 0; i < 10; i++)
+        {
+            editedPtr->Remove(random.RandRange(0, editedPtr->Size() - 1));
+        }
+        traces.Emplace("10 scattered removes", editedPtr);
+
+        editedPtr = basePtr->Clone()->AsList();
+        for (int i = 0; i < 50; i++)
+        {
+            editedPtr->Set(random.RandRange(0, editedPtr->Size() - 1), createElement());
+        }
+        traces.Emplace("50 scattered edits", editedPtr);
+
+        // Bytes are estimated as 12 bytes per vector plus 8 bytes of overhead per operation
+        const int elementBytes = sizeof(FVector);
+        const int operationBytes = 8;
+        for (const TPair<FString, sfListProperty::SPtr>& trace : traces)
+        {
+            int legacyOperations = 0;
+            int legacyElements = 0;
+            sfListProperty::SPtr destPtr = basePtr->Clone()->AsList();
+            double startTime = FPlatformTime::Seconds();
+            legacyCopyList(destPtr, trace.Value->Clone()->AsList(), legacyOperations, legacyElements);
+            double legacyMilliseconds = (FPlatformTime::Seconds() - startTime) * 1000.0;
+            bool legacyCorrect = destPtr->Equals(trace.Value);
+
+            sfPropertyUtil::GetListDiffStats() = sfPropertyUtil::ListDiffStats();
+            destPtr = basePtr->Clone()->AsList();
+            startTime = FPlatformTime::Seconds();
+            sfPropertyUtil::Copy(destPtr, trace.Value->Clone());
+            double milliseconds = (FPlatformTime::Seconds() - startTime) * 1000.0;
+            bool correct = destPtr->Equals(trace.Value);
+            const sfPropertyUtil::ListDiffStats& stats = sfPropertyUtil::GetListDiffStats();
+
+            KS::Log::Info(sfUtils::FToStdString(trace.Key) + ": old " + std::to_string(legacyOperations) + " ops, " +
+                std::to_string(legacyElements * elementBytes + legacyOperations * operationBytes) + " bytes, " +
+                std::to_string(legacyMilliseconds) + "ms" + (legacyCorrect ? "" : " (WRONG RESULT)") + "; new " +
+                std::to_string(stats.Operations) + " ops, " +
+                std::to_string(stats.Elements * elementBytes + stats.Operations * operationBytes) + " bytes, " +
+                std::to_string(milliseconds) + "ms" + (correct ? "" : " (WRONG RESULT)"), LOG_CHANNEL);
+        }
+    });
+
+    // Round-trips a TArray<double> through an sfListProperty with packed arrays disabled and enabled, and checks that
+    // the list is only treated as packed slices when packing is enabled.
+    Register("TestDoubleArray", [](const TArray<FString>& args)
+    {
+        int size = args.Num() > 0 ? FCString::Atoi(*args[0]) : 1000;
+        UArrayProperty* arrayPropPtr = NewObject<UArrayProperty>(GetTransientPackage(), NAME_None, RF_Transient);
+        arrayPropPtr->Inner = NewObject<UDoubleProperty>(arrayPropPtr, NAME_None, RF_Transient);
+        arrayPropPtr->ElementSize = sizeof(FScriptArray);
+        FRandomStream random(1234);
+        TArray<double> srcValues;
+        for (int i = 0; i < size; i++)
+        {
+            srcValues.Add((double)random.FRand() * 1000000.0);
+        }
+
+        bool packedArrays = sfConfig::Get().PackedArrays;
+        for (bool packed : { false, true })
+        {
+            sfConfig::Get().PackedArrays = packed;
+            TArray<double> destValues;
+            sfProperty::SPtr propPtr = sfPropertyUtil::GetValue(sfUPropertyInstance(arrayPropPtr, &srcValues));
+            bool correct = propPtr != nullptr && propPtr->Type() == sfProperty::LIST &&
+                sfPropertyUtil::IsPackedList(arrayPropPtr->Inner, propPtr->AsList()) == packed &&
+                sfPropertyUtil::SetValue(nullptr, sfUPropertyInstance(arrayPropPtr, &destValues), propPtr) &&
+                destValues == srcValues;
+            KS::Log::Info(std::string(packed ? "Packed" : "Unpacked") + ": " + std::to_string(size) + " doubles" +
+                (correct ? "" : " (WRONG RESULT)"), LOG_CHANNEL);
+        }
+        sfConfig::Get().PackedArrays = packedArrays;
+    });
+
+    // Encodes random component and avatar transforms with the quantized transform encodings and reports the bytes per
+    // transform, the max errors, and the number of values that changed when re-encoded after decoding.
+    Register("BenchmarkTransforms", [](const TArray<FString>& args)
+    {
+        int count = args.Num() > 0 ? FCString::Atoi(*args[0]) : 10000;
+        float range = args.Num() > 1 ? FCString::Atof(*args[1]) : 50000.0f;
+        int precisionBits = sfConfig::Get().LocationPrecisionBits;
+        FRandomStream random(1234);
+        auto getSize = [](sfValueProperty::SPtr propPtr)
+        {
+            return (int)propPtr->GetValue().GetData().size();
+        };
+        auto isStable = [](sfValueProperty::SPtr propPtr, sfValueProperty::SPtr reencodedPtr)
+        {
+            return reencodedPtr != nullptr && propPtr->Equals(reencodedPtr);
+        };
+
+        int componentBytes = 0;
+        int avatarBytes = 0;
+        int fallbacks = 0;
+        int unstable = 0;
+        float maxLocationError = 0.0f;
+        float maxRotatorError = 0.0f;
+        float maxQuatError = 0.0f;
+        for (int i = 0; i < count; i++)
+        {
+            FVector location(random.FRandRange(-range, range), random.FRandRange(-range, range),
+                random.FRandRange(-range, range));
+            FRotator rotator(random.FRandRange(-360.0f, 360.0f), random.FRandRange(-360.0f, 360.0f),
+                random.FRandRange(-360.0f, 360.0f));
+            FVector scale = random.FRand() < 0.5f ? FVector(random.FRandRange(0.1f, 10.0f)) :
+                FVector(random.FRandRange(0.1f, 10.0f), random.FRandRange(0.1f, 10.0f), random.FRandRange(0.1f, 10.0f));
+            FQuat quat = rotator.Quaternion();
+
+            sfValueProperty::SPtr locationPtr = sfTransformCodec::EncodeLocation(location, precisionBits);
+            if (locationPtr == nullptr)
+            {
+                fallbacks++;
+                componentBytes += sizeof(FVector);
+                avatarBytes += sizeof(FVector);
+            }
+            else
+            {
+                FVector decoded;
+                sfTransformCodec::DecodeLocation(locationPtr->GetValue(), decoded);
+                maxLocationError = FMath::Max(maxLocationError, (decoded - location).GetAbsMax());
+                unstable += isStable(locationPtr, sfTransformCodec::EncodeLocation(decoded, precisionBits)) ? 0 : 1;
+                componentBytes += getSize(locationPtr);
+                avatarBytes += getSize(locationPtr);
+            }
+
+            sfValueProperty::SPtr rotatorPtr = sfTransformCodec::EncodeRotator(rotator);
+            FRotator decodedRotator;
+            sfTransformCodec::DecodeRotator(rotatorPtr->GetValue(), decodedRotator);
+            maxRotatorError = FMath::Max(maxRotatorError, FMath::RadiansToDegrees(
+                quat.AngularDistance(decodedRotator.Quaternion())));
+            unstable += isStable(rotatorPtr, sfTransformCodec::EncodeRotator(decodedRotator)) ? 0 : 1;
+            componentBytes += getSize(rotatorPtr);
+
+            sfValueProperty::SPtr scalePtr = sfTransformCodec::EncodeScale(scale);
+            if (scalePtr == nullptr)
+            {
+                componentBytes += sizeof(FVector);
+            }
+            else
+            {
+                FVector decoded;
+                sfTransformCodec::DecodeScale(scalePtr->GetValue(), decoded);
+                unstable += isStable(scalePtr, sfTransformCodec::EncodeScale(decoded)) ? 0 : 1;
+                componentBytes += getSize(scalePtr);
+            }
+
+            sfValueProperty::SPtr quatPtr = sfTransformCodec::EncodeQuat(quat);
+            if (quatPtr == nullptr)
+            {
+                fallbacks++;
+                avatarBytes += sizeof(FQuat);
+            }
+            else
+            {
+                FQuat decoded;
+                sfTransformCodec::DecodeQuat(quatPtr->GetValue(), decoded);
+                maxQuatError = FMath::Max(maxQuatError, FMath::RadiansToDegrees(quat.AngularDistance(decoded)));
+                unstable += isStable(quatPtr, sfTransformCodec::EncodeQuat(decoded)) ? 0 : 1;
+                avatarBytes += getSize(quatPtr);
+            }
+        }
+
+        count = FMath::Max(count, 1);
+        KS::Log::Info("Component transforms: " + std::to_string(componentBytes / (float)count) +
+            " bytes (full precision " + std::to_string(sizeof(FVector) * 2 + sizeof(FRotator)) +
+            "). Avatar transforms: " + std::to_string(avatarBytes / (float)count) + " bytes (full precision " +
+            std::to_string(sizeof(FVector) + sizeof(FQuat)) + ").", LOG_CHANNEL);
+        KS::Log::Info("Max errors: location " + std::to_string(maxLocationError) + ", rotator " +
+            std::to_string(maxRotatorError) + " degrees, quat " + std::to_string(maxQuatError) + " degrees. " +
+            std::to_string(fallbacks) + " values sent at full precision, " + std::to_string(unstable) +
+            " values changed when re-encoded.", LOG_CHANNEL);
+    });
+
+    // Times adding, looking up and removing sfObject/uobject mappings in the object map and in the hash maps it
+    // replaced. Pass entry counts as arguments to override the default sizes of 10k, 100k and 1M. The uobject pointers
+    // are fake and never dereferenced.
+    Register("BenchmarkObjectMap", [](const TArray<FString>& args)
+    {
+        if (SceneFusion::Service->Session() != nullptr)
+        {
+            KS::Log::Warning("You must leave the session to benchmark the object map.", LOG_CHANNEL);
+            return;
+        }
+        TArray<int> sizes;
+        for (const FString& arg : args)
+        {
+            sizes.Add(FCString::Atoi(*arg));
+        }
+        if (sizes.Num() == 0)
+        {
+            sizes = { 10000, 100000, 1000000 };
+        }
+        FRandomStream random(1234);
+        for (int size : sizes)
+        {
+            std::vector<sfObject::SPtr> objects;
+            std::vector<UObject*> uobjects;
+            for (int i = 0; i < size; i++)
+            {
+                // Actors and components are partitioned by level, which reads the uobject, so use another type
+                objects.push_back(sfObject::Create(sfType::PropertyTemplate));
+                uobjects.push_back(reinterpret_cast<UObject*>((UPTRINT)(i + 1) * 64));
+            }
+            // Look up in a different order than added
+            TArray<int> order;
+            for (int i = 0; i < size; i++)
+            {
+                order.Add(i);
+            }
+            for (int i = size - 1; i > 0; i--)
+            {
+                order.Swap(i, random.RandRange(0, i));
+            }
+
+            TMap<const UObject*, sfObject::SPtr> legacyUToSFObjectMap;
+            std::unordered_map<sfObject::SPtr, UObject*> legacySFToUObjectMap;
+            double startTime = FPlatformTime::Seconds();
+            for (int i = 0; i < size; i++)
+            {
+                legacySFToUObjectMap[objects[i]] = uobjects[i];
+                legacyUToSFObjectMap.Add(uobjects[i], objects[i]);
+            }
+            double legacyAdd = FPlatformTime::Seconds() - startTime;
+            int found = 0;
+            startTime = FPlatformTime::Seconds();
+            for (int i : order)
+            {
+                auto iter = legacySFToUObjectMap.find(objects[i]);
+                found += iter != legacySFToUObjectMap.end() && iter->second == uobjects[i] ? 1 : 0;
+            }
+            double legacyGetUObject = FPlatformTime::Seconds() - startTime;
+            startTime = FPlatformTime::Seconds();
+            for (int i : order)
+            {
+                found += legacyUToSFObjectMap.FindRef(uobjects[i]) == objects[i] ? 1 : 0;
+            }
+            double legacyGetSFObject = FPlatformTime::Seconds() - startTime;
+            startTime = FPlatformTime::Seconds();
+            for (int i : order)
+            {
+                sfObject::SPtr objPtr = nullptr;
+                if (legacyUToSFObjectMap.RemoveAndCopyValue(uobjects[i], objPtr))
+                {
+                    legacySFToUObjectMap.erase(objPtr);
+                }
+            }
+            double legacyRemove = FPlatformTime::Seconds() - startTime;
+            bool legacyCorrect = found == size * 2;
+
+            sfObjectMap::Clear();
+            startTime = FPlatformTime::Seconds();
+            for (int i = 0; i < size; i++)
+            {
+                sfObjectMap::Add(objects[i], uobjects[i]);
+            }
+            double add = FPlatformTime::Seconds() - startTime;
+            found = 0;
+            startTime = FPlatformTime::Seconds();
+            for (int i : order)
+            {
+                found += sfObjectMap::GetUObject(objects[i]) == uobjects[i] ? 1 : 0;
+            }
+            double getUObject = FPlatformTime::Seconds() - startTime;
+            startTime = FPlatformTime::Seconds();
+            for (int i : order)
+            {
+                found += sfObjectMap::GetSFObject(uobjects[i]) == objects[i] ? 1 : 0;
+            }
+            double getSFObject = FPlatformTime::Seconds() - startTime;
+            startTime = FPlatformTime::Seconds();
+            for (int i : order)
+            {
+                sfObjectMap::Remove(uobjects[i]);
+            }
+            double remove = FPlatformTime::Seconds() - startTime;
+            bool correct = found == size * 2 && sfObjectMap::Num() == 0;
+            sfObjectMap::Clear();
+
+            auto format = [size](double seconds)
+            {
+                return std::to_string(seconds * 1000000000.0 / FMath::Max(size, 1)) + "ns";
+            };
+            KS::Log::Info(std::to_string(size) + " entries (per entry): old add " + format(legacyAdd) +
+                ", GetUObject " + format(legacyGetUObject) + ", GetSFObject " + format(legacyGetSFObject) +
+                ", remove " + format(legacyRemove) + (legacyCorrect ? "" : " (WRONG RESULT)") + "; new add " +
+                format(add) + ", GetUObject " + format(getUObject) + ", GetSFObject " + format(getSFObject) +
+                ", remove " + format(remove) + (correct ? "" : " (WRONG RESULT)"), LOG_CHANNEL);
+        }
+    });
+
+    // Builds an unsynced level-like hierarchy and times iterating it with ForEachDescendant, DescendantIter and
+    // VisitDescendants, and visiting the level's children in reverse with Child(i) and with a copied list. Pass the
+    // number of actors and components per actor to override the defaults of 10k and 3.
+    Register("BenchmarkHierarchy", [](const TArray<FString>& args)
+    {
+        int numActors = args.Num() > 0 ? FCString::Atoi(*args[0]) : 10000;
+        int numComponents = args.Num() > 1 ? FCString::Atoi(*args[1]) : 3;
+        sfObject::SPtr levelObjPtr = sfObject::Create(sfType::Level);
+        for (int i = 0; i < numActors; i++)
+        {
+            sfObject::SPtr actorObjPtr = sfObject::Create(sfType::Actor);
+            for (int j = 0; j < numComponents; j++)
+            {
+                actorObjPtr->AddChild(sfObject::Create(sfType::Component));
+            }
+            levelObjPtr->AddChild(actorObjPtr);
+        }
+
+        int visited = 0;
+        double startTime = FPlatformTime::Seconds();
+        levelObjPtr->ForEachDescendant([&visited](sfObject::SPtr objPtr)
+        {
+            visited++;
+            return true;
+        });
+        double forEach = FPlatformTime::Seconds() - startTime;
+        startTime = FPlatformTime::Seconds();
+        for (auto iter = levelObjPtr->Descendants(); iter.Value() != nullptr; iter.Next())
+        {
+            visited++;
+        }
+        double iterator = FPlatformTime::Seconds() - startTime;
+        startTime = FPlatformTime::Seconds();
+        sfUtils::VisitDescendants(levelObjPtr, [&visited](const sfObject::SPtr& objPtr)
+        {
+            visited++;
+            return true;
+        });
+        double visit = FPlatformTime::Seconds() - startTime;
+        startTime = FPlatformTime::Seconds();
+        for (int i = levelObjPtr->Children().size() - 1; i >= 0; i--)
+        {
+            visited += levelObjPtr->Child(i) != nullptr ? 1 : 0;
+        }
+        double childAt = FPlatformTime::Seconds() - startTime;
+        startTime = FPlatformTime::Seconds();
+        std::vector<sfObject::SPtr> children(levelObjPtr->Children().rbegin(), levelObjPtr->Children().rend());
+        for (const sfObject::SPtr& childPtr : children)
+        {
+            visited += childPtr != nullptr ? 1 : 0;
+        }
+        double copy = FPlatformTime::Seconds() - startTime;
+
+        int expected = numActors * (numComponents + 1) * 3 + numActors * 2;
+        KS::Log::Info(std::to_string(numActors) + " actors with " + std::to_string(numComponents) +
+            " components: ForEachDescendant " + std::to_string(forEach * 1000.0) + "ms, DescendantIter " +
+            std::to_string(iterator * 1000.0) + "ms, VisitDescendants " + std::to_string(visit * 1000.0) +
+            "ms; reverse children with Child(i) " + std::to_string(childAt * 1000.0) + "ms, copied " +
+            std::to_string(copy * 1000.0) + "ms" + (visited == expected ? "." : " (WRONG RESULT)."), LOG_CHANNEL);
+    });
+
+    // Times building the selection set that is diffed when the selection changes and the selection count that is
+    // checked every tick. Select many actors before running this.
+    Register("BenchmarkSelection", [](const TArray<FString>& args)
+    {
+        int iterations = args.Num() > 0 ? FCString::Atoi(*args[0]) : 100;
+        if (iterations <= 0)
+        {
+            return;
+        }
+        int found = 0;
+        double startTime = FPlatformTime::Seconds();
+        for (int i = 0; i < iterations; i++)
+        {
+            found += sfDetailsPanelManager::Get().GetSelectedActors().Num();
+        }
+        double set = FPlatformTime::Seconds() - startTime;
+        startTime = FPlatformTime::Seconds();
+        for (int i = 0; i < iterations; i++)
+        {
+            found += sfDetailsPanelManager::Get().GetSelectedActorCount();
+        }
+        double count = FPlatformTime::Seconds() - startTime;
+        KS::Log::Info(std::to_string(found / (iterations * 2)) + " selected actors: selection set " +
+            std::to_string(set * 1000.0 / iterations) + "ms, selection count " +
+            std::to_string(count * 1000.0 / iterations) + "ms.", LOG_CHANNEL);
+    });
+
+    // Selects up to the given number of synced actors (10k by default) and reports how long it takes for the server to
+    // grant all of their locks. Nobody else should be editing the actors.
+    Register("BenchmarkLocks", [](const TArray<FString>& args)
+    {
+        sfSession::SPtr sessionPtr = SceneFusion::Service->Session();
+        if (sessionPtr == nullptr)
+        {
+            KS::Log::Warning("You must be in a session to benchmark locks.", LOG_CHANNEL);
+            return;
+        }
+        int count = args.Num() > 0 ? FCString::Atoi(*args[0]) : 10000;
+        std::vector<sfObject::SPtr> objects;
+        GEditor->SelectNone(true, true);
+        GEditor->GetSelectedActors()->BeginBatchSelectOperation();
+        for (TActorIterator<AActor> iter(GEditor->GetEditorWorldContext().World());
+            iter && (int)objects.size() < count; ++iter)
+        {
+            sfObject::SPtr objPtr = sfObjectMap::GetSFObject(*iter);
+            if (objPtr != nullptr && objPtr->IsSyncing() && !objPtr->IsLocked())
+            {
+                GEditor->SelectActor(*iter, true, false);
+                objects.push_back(objPtr);
+            }
+        }
+        GEditor->GetSelectedActors()->EndBatchSelectOperation();
+        GEditor->NoteSelectionChange();
+        if (objects.empty())
+        {
+            KS::Log::Warning("There are no unlocked synced actors to lock.", LOG_CHANNEL);
+            return;
+        }
+        sfUser::SPtr localUserPtr = sessionPtr->LocalUser();
+        double startTime = FPlatformTime::Seconds();
+        FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+            [objects, localUserPtr, startTime](float deltaTime)
+        {
+            int granted = 0;
+            for (const sfObject::SPtr& objPtr : objects)
+            {
+                granted += !objPtr->IsLockPending() && objPtr->LockOwner() == localUserPtr ? 1 : 0;
+            }
+            double seconds = FPlatformTime::Seconds() - startTime;
+            if (granted < (int)objects.size() && seconds < 60.0 && SceneFusion::Service->Session() != nullptr)
+            {
+                return true;
+            }
+            KS::Log::Info(std::to_string(granted) + " of " + std::to_string(objects.size()) + " locks granted in " +
+                std::to_string(seconds) + "s.", LOG_CHANNEL);
+            return false;
+        }));
+    });
 }
 
 sfAction::~sfAction()
@@ -301,6 +301,19 @@ TSet<AActor*> sfDetailsPanelManager::GetSelectedActors()
     return selectedActors;
 }
 
+int sfDetailsPanelManager::GetSelectedActorCount()
+{
+    int count = GEditor->GetSelectedActorCount();
+    for (TSharedPtr<IDetailsView> detailsViewPtr : m_detailsViews)
+    {
+        if (detailsViewPtr.IsValid() && detailsViewPtr->IsLocked())
+        {
+            count += detailsViewPtr->GetSelectedActors().Num();
+        }
+    }
+    return count;
+}
+
 bool sfDetailsPanelManager::CanEdit(const TArray<TWeakObjectPtr<UObject>>& objects)
 {
     AActor* actorPtr;
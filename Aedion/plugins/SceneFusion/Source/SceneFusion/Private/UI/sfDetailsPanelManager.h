@@ -57,6 +57,14 @@ public:
      */
     TSet<AActor*> GetSelectedActors();
 
+    /**
+     * Returns the number of selected actors plus the number of actors inspected by locked detail panels, without
+     * building the selection set. Use this to cheaply check if the selection may have changed.
+     *
+     * @return  int
+     */
+    int GetSelectedActorCount();
+
 private:
     /**
      * Edit mode class to prevent editing when selected actors contains locked actors.
@@ -3,6 +3,7 @@
 #include "sfUICommands.h"
 #include "../SceneFusion.h"
 #include "../sfConfig.h"
+#include "../sfStandInCache.h"
 #include "../ObjectManagers/sfActorManager.h"
 
 #include <iostream>
@@ -181,6 +182,7 @@ void sfUI::JoinSession(TSharedPtr<sfSessionInfo> sessionInfoPtr)
     std::string token(TCHAR_TO_UTF8(*sfConfig::Get().SFToken));
     std::string username(TCHAR_TO_UTF8(*sfConfig::Get().Name));
     std::string application(TCHAR_TO_UTF8(*version));
+    sfStandInCache::SetSession(sessionInfoPtr->ProjectName + "_" + FString::FromInt(sessionInfoPtr->RoomInfoPtr->Id()));
     SceneFusion::Service->JoinSession(sessionInfoPtr->RoomInfoPtr, token, username, application,
         [this](sfSession::SPtr sessionPtr, const std::string& errorMessage)
     {
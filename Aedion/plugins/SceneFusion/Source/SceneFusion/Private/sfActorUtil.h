@@ -53,8 +53,10 @@ public:
      * This causes Unreal to refresh the details panel and notice changes to the component hierarchy.
      * 
      * @param   AActor* actorPtr to reselect. Does nothing if the actor is not already selected.
+     * @param   bool notify - if false, the editor is not notified of the selection change. Call
+     *          GEditor->NoteSelectionChange() after reselecting several actors instead.
      */
-    static void Reselect(AActor* actorPtr)
+    static void Reselect(AActor* actorPtr, bool notify = true)
     {
         if (actorPtr == nullptr || !actorPtr->IsSelected())
         {
@@ -71,11 +73,11 @@ public:
                 }
             }
         }
-        GEditor->SelectActor(actorPtr, false, true);
-        GEditor->SelectActor(actorPtr, true, true);
+        GEditor->SelectActor(actorPtr, false, notify);
+        GEditor->SelectActor(actorPtr, true, notify);
         for (UActorComponent* componentPtr : selectedComponents)
         {
-            GEditor->SelectComponent(componentPtr, true, true);
+            GEditor->SelectComponent(componentPtr, true, notify);
         }
     }
 
@@ -21,7 +21,16 @@ private:
         MockWebServerAddress(""),
         MockWebServerPort(""),
         ShowAvatar(true),
-        IdleTime(0.5)
+        IdleTime(0.5),
+        BlittableStructs(false),
+        PackedArrays(false),
+        QuantizeTransforms(false),
+        LocationPrecisionBits(6),
+        PropertySyncInterval(0.1f),
+        SchemaRecords(false),
+        AsyncAssetLoading(true),
+        AssetLoadBudget(5.0f),
+        PrefetchAssets(true)
     {}
 
 public:
@@ -46,6 +55,34 @@ public:
     FString MockWebServerPort;
     bool ShowAvatar;
     float IdleTime;
+    // Send registered plain-old-data structs as raw bytes with zeroed padding. Only enable this when all clients in
+    // the session understand raw struct bytes.
+    bool BlittableStructs;
+    // Send arrays of numbers and blittable structs as lists of typed array slices. Only enable this when all clients in
+    // the session understand packed arrays.
+    bool PackedArrays;
+    // Send component and avatar transforms with quantized encodings. Only enable this when all clients in the session
+    // understand quantized transforms.
+    bool QuantizeTransforms;
+    // Quantized locations are rounded to multiples of 2^-LocationPrecisionBits units. The default of 6 rounds to 1/64
+    // of a centimeter with a range of 1.3 kilometers from the origin. Locations out of range are sent at full
+    // precision.
+    int LocationPrecisionBits;
+    // Minimum seconds between sending interactive property changes, such as dragging a slider. The first and last
+    // changes are always sent. Use sfPropertyUtil::SetSyncInterval to override this for classes or properties.
+    float PropertySyncInterval;
+    // Send the properties of new actors and components as ordered records that refer to a shared schema object per
+    // class instead of as named fields. Disable this when in sessions with clients that do not understand records.
+    bool SchemaRecords;
+    // Load assets referenced by other users' objects asynchronously instead of on the game thread when the user is
+    // idle.
+    bool AsyncAssetLoading;
+    // Milliseconds per tick to spend applying loaded assets to the objects that reference them, and loading delayed
+    // assets when the user is idle.
+    float AssetLoadBudget;
+    // Start loading every asset referenced by a level's objects in one batch when the objects are received, before
+    // their actors are spawned. Only used when AsyncAssetLoading is enabled.
+    bool PrefetchAssets;
 
     /**
      * Relative Path to the Scene Fusion configuration file.
@@ -74,6 +111,15 @@ public:
         configs.Add("MockWebServerPort=" + MockWebServerPort);
         configs.Add("ShowAvatar=" + FString((ShowAvatar ? "true" : "false")));
         configs.Add("IdleTime=" + FString::SanitizeFloat(IdleTime));
+        configs.Add("BlittableStructs=" + FString((BlittableStructs ? "true" : "false")));
+        configs.Add("PackedArrays=" + FString((PackedArrays ? "true" : "false")));
+        configs.Add("QuantizeTransforms=" + FString((QuantizeTransforms ? "true" : "false")));
+        configs.Add("LocationPrecisionBits=" + FString::FromInt(LocationPrecisionBits));
+        configs.Add("PropertySyncInterval=" + FString::SanitizeFloat(PropertySyncInterval));
+        configs.Add("SchemaRecords=" + FString((SchemaRecords ? "true" : "false")));
+        configs.Add("AsyncAssetLoading=" + FString((AsyncAssetLoading ? "true" : "false")));
+        configs.Add("AssetLoadBudget=" + FString::SanitizeFloat(AssetLoadBudget));
+        configs.Add("PrefetchAssets=" + FString((PrefetchAssets ? "true" : "false")));
         FFileHelper::SaveStringArrayToFile(configs, *Path());
     }
 
@@ -142,6 +188,51 @@ public:
                         IdleTime = FCString::Atof(*value);
                         continue;
                     }
+                    if (key.Equals("BlittableStructs"))
+                    {
+                        BlittableStructs = value == "true";
+                        continue;
+                    }
+                    if (key.Equals("PackedArrays"))
+                    {
+                        PackedArrays = value == "true";
+                        continue;
+                    }
+                    if (key.Equals("QuantizeTransforms"))
+                    {
+                        QuantizeTransforms = value == "true";
+                        continue;
+                    }
+                    if (key.Equals("LocationPrecisionBits"))
+                    {
+                        LocationPrecisionBits = FCString::Atoi(*value);
+                        continue;
+                    }
+                    if (key.Equals("PropertySyncInterval"))
+                    {
+                        PropertySyncInterval = FCString::Atof(*value);
+                        continue;
+                    }
+                    if (key.Equals("SchemaRecords"))
+                    {
+                        SchemaRecords = value == "true";
+                        continue;
+                    }
+                    if (key.Equals("AsyncAssetLoading"))
+                    {
+                        AsyncAssetLoading = value == "true";
+                        continue;
+                    }
+                    if (key.Equals("AssetLoadBudget"))
+                    {
+                        AssetLoadBudget = FCString::Atof(*value);
+                        continue;
+                    }
+                    if (key.Equals("PrefetchAssets"))
+                    {
+                        PrefetchAssets = value == "true";
+                        continue;
+                    }
                 }
             }
         }
@@ -9,7 +9,8 @@ class sfIStandInGenerator
 {
 public:
     /**
-     * Generates stand-in data for a missing asset.
+     * Generates stand-in data for a missing asset. This is called from the loader's tick after the stand-in is created
+     * and may already be referenced by objects.
      *
      * @param   const FString& path of missing asset.
      * @param   UObject* uobjPtr stand-in to generate data for.
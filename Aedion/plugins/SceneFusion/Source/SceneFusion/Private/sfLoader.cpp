@@ -3,9 +3,11 @@
 #include "sfObjectMap.h"
 #include "sfConfig.h"
 #include "sfUtils.h"
+#include "sfStandInCache.h"
 #include "consts.h"
 
 #include <Editor.h>
+#include <LevelEditorViewport.h>
 #include <Log.h>
 #include <sfPropertyIterator.h>
 #include <sfConfig.h>
@@ -15,6 +17,8 @@
 #include <Engine/SkeletalMesh.h>
 #include <../Plugins/2D/Paper2D/Source/Paper2D/Classes/PaperSprite.h>
 #include <Developer/RawMesh/Public/RawMesh.h>
+#include <Framework/Notifications/NotificationManager.h>
+#include <Widgets/Notifications/SNotificationList.h>
 
 #define LOG_CHANNEL "sfLoader"
 
@@ -30,9 +34,16 @@ sfLoader& sfLoader::Get()
 }
 
 sfLoader::sfLoader() :
+    m_numAsyncLoads{ 0 },
+    m_numAsyncLoadsCompleted{ 0 },
+    m_numPrefetchBatches{ 0 },
+    m_prefetchSession{ 0 },
+    m_startTime{ 0.0 },
+    m_prefetchStartTime{ 0.0 },
     m_replaceTimer{ 0.0f },
     m_isMouseDown{ false },
-    m_overrideIdle{ false }
+    m_overrideIdle{ false },
+    m_wasIdle{ false }
 {
     m_standInPaths.Add(USkeletalMesh::StaticClass(), "/SceneFusion/StandIns/Skeletal");
     m_standInPaths.Add(UMaterial::StaticClass(), "/SceneFusion/StandIns/Material");
@@ -42,6 +53,9 @@ sfLoader::sfLoader() :
 
 void sfLoader::Start()
 {
+    m_startTime = FPlatformTime::Seconds();
+    m_joinStats = JoinStats();
+    sfStandInCache::Load();
     FSlateApplication::Get().RegisterInputPreProcessor(m_instancePtr);
     m_onNewAssetHandle = UAssetManager::Get().GetAssetRegistry().OnAssetAdded().AddRaw(this, &sfLoader::OnNewAsset);
 }
@@ -50,12 +64,35 @@ void sfLoader::Stop()
 {
     m_isMouseDown = false;
     m_delayedAssets.clear();
+    m_delayedObjects.Empty();
+    for (auto& iter : m_asyncLoads)
+    {
+        if (iter.Value.Handle.IsValid())
+        {
+            iter.Value.Handle->CancelHandle();
+        }
+    }
+    m_asyncLoads.Empty();
+    m_loadedProperties.Empty();
+    // Ignore the cancel callbacks from the prefetch batches
+    m_prefetchSession++;
+    for (TSharedPtr<FStreamableHandle>& handle : m_prefetchHandles)
+    {
+        handle->CancelHandle();
+    }
+    m_prefetchHandles.Empty();
+    m_prefetchedIds.clear();
+    m_numPrefetchBatches = 0;
+    UpdateProgress();
     for (auto iter : m_standIns)
     {
         iter.Value->ClearFlags(RF_Standalone);// Allow Unreal to destroy the stand-ins
     }
     m_standIns.Empty();
+    m_standInReferences.clear();
     m_standInsToReplace.Empty();
+    m_standInsToGenerate.Empty();
+    sfStandInCache::Save();
     FSlateApplication::Get().UnregisterInputPreProcessor(m_instancePtr);
     UAssetManager::Get().GetAssetRegistry().OnAssetAdded().Remove(m_onNewAssetHandle);
 }
@@ -72,15 +109,185 @@ bool sfLoader::IsUserIdle()
         sfConfig::Get().IdleTime);
 }
 
+bool sfLoader::CanLoadNow()
+{
+    return m_overrideIdle || (!sfConfig::Get().AsyncAssetLoading && IsUserIdle());
+}
+
+void sfLoader::LoadLater(sfProperty::SPtr propPtr)
+{
+    FString path, className;
+    if (sfConfig::Get().AsyncAssetLoading && sfPropertyUtil::ToString(propPtr).Split(";", &className, &path))
+    {
+        LoadAsync(propPtr, path);
+    }
+    else
+    {
+        LoadWhenIdle(propPtr);
+    }
+}
+
 void sfLoader::LoadWhenIdle(sfProperty::SPtr propPtr)
 {
-    std::vector<sfProperty::SPtr>& properties = m_delayedAssets[propPtr->GetContainerObject()];
+    sfObject::SPtr objPtr = propPtr->GetContainerObject();
+    auto iter = m_delayedAssets.find(objPtr);
+    if (iter == m_delayedAssets.end())
+    {
+        iter = m_delayedAssets.emplace(objPtr, std::vector<sfProperty::SPtr>()).first;
+        m_delayedObjects.HeapPush(DelayedObject{ objPtr, GetLoadPriority(objPtr) });
+    }
+    std::vector<sfProperty::SPtr>& properties = iter->second;
     if (std::find(properties.begin(), properties.end(), propPtr) == properties.end())
     {
         properties.emplace_back(propPtr);
     }
 }
 
+void sfLoader::Prefetch(sfObject::SPtr rootPtr)
+{
+    if (!sfConfig::Get().AsyncAssetLoading || !sfConfig::Get().PrefetchAssets)
+    {
+        return;
+    }
+    double startTime = FPlatformTime::Seconds();
+    m_joinStats.Network = startTime - m_startTime;
+    TArray<FSoftObjectPath> paths;
+    auto collectPaths = [this, &paths](const sfObject::SPtr& objPtr)
+    {
+        // Only actors and components have classes we can find asset reference properties on
+        sfProperty::SPtr classPropPtr;
+        FString className;
+        if (objPtr->Property() == nullptr || objPtr->Property()->Type() != sfProperty::DICTIONARY ||
+            !objPtr->Property()->AsDict()->TryGet(sfProp::Class, classPropPtr) ||
+            classPropPtr->Type() != sfProperty::VALUE ||
+            classPropPtr->AsValue()->GetValue().GetType() != ksMultiType::UINT ||
+            !sfPropertyUtil::TryGetStringFromTable(classPropPtr->AsValue()->GetValue(), className))
+        {
+            return true;
+        }
+        UClass* classPtr = FindClass(className);
+        if (classPtr == nullptr)
+        {
+            // The properties can't be checked until the blueprint is loaded, so we prefetch the blueprint instead.
+            if (className.StartsWith("/") && m_prefetchedIds.insert(classPropPtr->AsValue()->GetValue()).second &&
+                LoadFromCache(className) == nullptr)
+            {
+                paths.Emplace(className);
+            }
+            return true;
+        }
+        for (auto iter = objPtr->Property()->Iterate(); iter.Value() != nullptr; iter.Next())
+        {
+            if (iter.Value()->Type() != sfProperty::VALUE)
+            {
+                continue;
+            }
+            const ksMultiType& value = iter.Value()->AsValue()->GetValue();
+            if (value.GetType() != ksMultiType::UINT || !sfPropertyUtil::IsAssetReference(classPtr, iter.Value()))
+            {
+                continue;
+            }
+            // Many objects reference the same assets, so each string is only checked once.
+            uint32_t id = value;
+            if (!m_prefetchedIds.insert(id).second)
+            {
+                continue;
+            }
+            // Asset references are "class;path" strings
+            FString str, assetClassName, path;
+            if (sfPropertyUtil::TryGetStringFromTable(id, str) && str.Split(";", &assetClassName, &path) &&
+                path.StartsWith("/") && LoadFromCache(path) == nullptr && !sfStandInCache::IsMissing(path))
+            {
+                paths.Emplace(path);
+            }
+        }
+        return true;
+    };
+    collectPaths(rootPtr);
+    sfUtils::VisitDescendants(rootPtr, collectPaths);
+    if (paths.Num() == 0)
+    {
+        return;
+    }
+    if (m_joinStats.Assets == 0)
+    {
+        m_prefetchStartTime = startTime;
+    }
+    m_joinStats.Assets += paths.Num();
+    m_numPrefetchBatches++;
+    KS::Log::Debug("Prefetching " + std::to_string(paths.Num()) + " asset(s).", LOG_CHANNEL);
+    // The session is passed to the delegates so batches from a previous session are ignored.
+    TSharedPtr<FStreamableHandle> handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(paths,
+        FStreamableDelegate::CreateRaw(this, &sfLoader::OnPrefetchComplete, m_prefetchSession));
+    if (handle.IsValid())
+    {
+        // Canceled batches never complete
+        handle->BindCancelDelegate(FStreamableDelegate::CreateRaw(this, &sfLoader::OnPrefetchComplete,
+            m_prefetchSession));
+        m_prefetchHandles.Add(handle);
+    }
+    else
+    {
+        // The request failed and the delegate will not be called
+        OnPrefetchComplete(m_prefetchSession);
+    }
+}
+
+UClass* sfLoader::FindClass(const FString& className)
+{
+    if (className.Contains("/"))
+    {
+        UBlueprint* blueprintPtr = FindObject<UBlueprint>(nullptr, *className);
+        if (blueprintPtr == nullptr)
+        {
+            return nullptr;
+        }
+        return blueprintPtr->GeneratedClass;
+    }
+    return FindObject<UClass>(ANY_PACKAGE, *className);
+}
+
+void sfLoader::OnPrefetchComplete(int session)
+{
+    if (session != m_prefetchSession || m_numPrefetchBatches <= 0)
+    {
+        return;
+    }
+    m_numPrefetchBatches--;
+    m_joinStats.IO = FPlatformTime::Seconds() - m_prefetchStartTime;
+    if (m_numPrefetchBatches == 0)
+    {
+        KS::Log::Debug("Prefetched " + std::to_string(m_joinStats.Assets) + " asset(s). Join timeline: network " +
+            std::to_string(m_joinStats.Network) + "s, I/O " + std::to_string(m_joinStats.IO) + "s, apply " +
+            std::to_string(m_joinStats.Apply) + "s.", LOG_CHANNEL);
+    }
+}
+
+void sfLoader::AddStandInReferences(sfProperty::SPtr propPtr)
+{
+    if (m_standInReferences.size() == 0 || propPtr == nullptr)
+    {
+        return;
+    }
+    for (auto iter = propPtr->Iterate(); iter.Value() != nullptr; iter.Next())
+    {
+        if (iter.Value()->Type() != sfProperty::VALUE)
+        {
+            continue;
+        }
+        sfValueProperty::SPtr valuePtr = iter.Value()->AsValue();
+        if (valuePtr->GetValue().GetType() != ksMultiType::UINT)
+        {
+            continue;
+        }
+        auto referencesIter = m_standInReferences.find(valuePtr->GetValue());
+        if (referencesIter != m_standInReferences.end())
+        {
+            referencesIter->second.insert(valuePtr);
+        }
+    }
+}
+
 void sfLoader::LoadAssetsFor(sfObject::SPtr objPtr)
 {
     auto iter = m_delayedAssets.find(objPtr);
@@ -94,6 +301,33 @@ void sfLoader::LoadAssetsFor(sfObject::SPtr objPtr)
         m_overrideIdle = false;
         m_delayedAssets.erase(iter);
     }
+    // Load pending async assets for the object now. The async loads still complete but will not find the properties.
+    // The properties are taken out of the async loads first because loading can flush async loading, which removes
+    // completed loads from the map.
+    std::vector<sfProperty::SPtr> toLoad;
+    for (auto asyncIter = m_asyncLoads.CreateIterator(); asyncIter; ++asyncIter)
+    {
+        std::vector<sfProperty::SPtr>& properties = asyncIter.Value().Properties;
+        for (size_t i = properties.size(); i-- > 0;)
+        {
+            if (properties[i]->GetContainerObject() == objPtr)
+            {
+                toLoad.push_back(properties[i]);
+                properties.erase(properties.begin() + i);
+            }
+        }
+        if (properties.size() == 0)
+        {
+            m_numAsyncLoadsCompleted++;
+            asyncIter.RemoveCurrent();
+        }
+    }
+    m_overrideIdle = true;
+    for (sfProperty::SPtr propPtr : toLoad)
+    {
+        LoadProperty(propPtr);
+    }
+    m_overrideIdle = false;
     for (sfObject::SPtr childPtr : objPtr->Children())
     {
         if (childPtr->Type() == sfType::Component)
@@ -105,10 +339,15 @@ void sfLoader::LoadAssetsFor(sfObject::SPtr objPtr)
 
 UObject* sfLoader::Load(const FString& path, const FString& className)
 {
-    UObject* assetPtr = LoadObject<UObject>(nullptr, *path);
-    if (assetPtr != nullptr)
+    // Don't search for assets that were missing the last time we were in this session
+    UObject* assetPtr;
+    if (!sfStandInCache::IsMissing(path))
     {
-        return assetPtr;
+        assetPtr = LoadObject<UObject>(nullptr, *path);
+        if (assetPtr != nullptr)
+        {
+            return assetPtr;
+        }
     }
 
     // Try to find a stand-in
@@ -149,14 +388,17 @@ UObject* sfLoader::Load(const FString& path, const FString& className)
         standInPtr = NewObject<UObject>(GEditor->GetEditorWorldContext().World(), classPtr, *name, flags);
     }
     
+    // Generating stand-in data can be slow, so it is done later within the tick's time budget.
     TSharedPtr<sfIStandInGenerator> generatorPtr;
     generatorPtr = m_standInGenerators.FindRef(classPtr);
     if (generatorPtr.IsValid())
     {
-        generatorPtr->Generate(path, standInPtr);
+        m_standInsToGenerate.Add(StandInToGenerate{ standInPtr, path, generatorPtr });
     }
 
+    sfStandInCache::AddMissing(path, className);
     m_standIns.Add(path, standInPtr);
+    m_standInReferences[sfPropertyUtil::GetStringTableId(className + ";" + path)];
 
     return standInPtr;
 }
@@ -302,6 +544,7 @@ void sfLoader::OnNewAsset(const FAssetData& assetData)
         return;
     }
     KS::Log::Debug("New asset found for stand-in '" + std::string(TCHAR_TO_UTF8(*path)) + "'.", LOG_CHANNEL);
+    sfStandInCache::Remove(path);
     standInPtr->ClearFlags(RF_Standalone);// Allow Unreal to destroy the stand-in 
     m_standInsToReplace.Add(standInPtr);
     // Wait .1 seconds to see if more assets are created that we can swap in all at once.
@@ -314,53 +557,234 @@ void sfLoader::ReplaceStandIns()
     {
         return;
     }
-    TSet<uint32_t> pathIds;
-    for (UObject* standInPtr : m_standInsToReplace)
-    {
-        pathIds.Add(SceneFusion::Service->Session()->GetStringTableId(TCHAR_TO_UTF8(*GetPathFromStandIn(standInPtr))));
-    }
     int count = 0;
-    for (auto iter = sfObjectMap::Begin(); iter != sfObjectMap::End(); ++iter)
+    for (UObject* standInPtr : m_standInsToReplace)
     {
-        for (auto propIter = iter->first->Property()->Iterate(); propIter.Value() != nullptr; propIter.Next())
+        uint32_t pathId = sfPropertyUtil::GetStringTableId(GetPathFromStandIn(standInPtr));
+        auto referencesIter = m_standInReferences.find(pathId);
+        if (referencesIter == m_standInReferences.end())
         {
-            if (propIter.Value()->Type() != sfProperty::VALUE)
+            continue;
+        }
+        for (const std::weak_ptr<sfValueProperty>& weakPtr : referencesIter->second)
+        {
+            // Skip values that were destroyed, removed from their object, or changed to a different asset.
+            sfValueProperty::SPtr valuePtr = weakPtr.lock();
+            if (valuePtr == nullptr || valuePtr->GetValue().GetType() != ksMultiType::UINT ||
+                (uint32_t)valuePtr->GetValue() != pathId)
             {
                 continue;
             }
-            sfValueProperty::SPtr valuePtr = propIter.Value()->AsValue();
-            if (valuePtr->GetValue().GetType() != ksMultiType::UINT)
+            UObject* uobjPtr = sfObjectMap::GetUObject(valuePtr->GetContainerObject());
+            if (uobjPtr == nullptr)
             {
                 continue;
             }
-            if (pathIds.Contains(valuePtr->GetValue()))
+            sfUPropertyInstance upropInstance = sfPropertyUtil::FindUProperty(uobjPtr, valuePtr);
+            if (sfPropertyUtil::SetValue(uobjPtr, upropInstance, valuePtr))
             {
-                sfUPropertyInstance upropInstance = sfPropertyUtil::FindUProperty(iter->second, valuePtr);
-                if (sfPropertyUtil::SetValue(iter->second, upropInstance, valuePtr))
-                {
-                    count++;
-                }
+                count++;
             }
         }
+        m_standInReferences.erase(referencesIter);
     }
     m_standInsToReplace.Empty();
     KS::Log::Debug("Replaced " + std::to_string(count) + " stand-in reference(s).", LOG_CHANNEL);
 }
 
+void sfLoader::GenerateStandIns()
+{
+    if (m_standInsToGenerate.Num() == 0)
+    {
+        return;
+    }
+    double endTime = FPlatformTime::Seconds() + sfConfig::Get().AssetLoadBudget / 1000.0;
+    int count = 0;
+    do
+    {
+        StandInToGenerate& standIn = m_standInsToGenerate[count];
+        count++;
+        // Skip stand-ins that were replaced by their assets
+        UObject* standInPtr = standIn.StandIn.Get();
+        if (standInPtr != nullptr && m_standIns.FindRef(standIn.Path) == standInPtr)
+        {
+            standIn.Generator->Generate(standIn.Path, standInPtr);
+        }
+    } while (count < m_standInsToGenerate.Num() && FPlatformTime::Seconds() < endTime);
+    m_standInsToGenerate.RemoveAt(0, count);
+}
+
 void sfLoader::LoadDelayedAssets()
 {
-    if (m_delayedAssets.size() == 0)
+    if (m_delayedObjects.Num() == 0)
     {
         return;
     }
-    for (auto iter : m_delayedAssets)
+    double startTime = FPlatformTime::Seconds();
+    double endTime = startTime + sfConfig::Get().AssetLoadBudget / 1000.0;
+    m_overrideIdle = true;
+    do
     {
-        for (sfProperty::SPtr propPtr : iter.second)
+        DelayedObject delayed;
+        m_delayedObjects.HeapPop(delayed, false);
+        auto iter = m_delayedAssets.find(delayed.Object);
+        if (iter == m_delayedAssets.end())
+        {
+            // The assets were loaded by LoadAssetsFor
+            continue;
+        }
+        std::vector<sfProperty::SPtr> properties = std::move(iter->second);
+        m_delayedAssets.erase(iter);
+        for (sfProperty::SPtr propPtr : properties)
         {
             LoadProperty(propPtr);
         }
+        m_delayedLoadStats.Loaded += (int)properties.size();
+    } while (m_delayedObjects.Num() > 0 && FPlatformTime::Seconds() < endTime);
+    m_overrideIdle = false;
+    m_delayedLoadStats.Seconds += FPlatformTime::Seconds() - startTime;
+}
+
+void sfLoader::PrioritizeDelayedAssets()
+{
+    for (DelayedObject& delayed : m_delayedObjects)
+    {
+        delayed.Priority = GetLoadPriority(delayed.Object);
+    }
+    m_delayedObjects.Heapify();
+}
+
+void sfLoader::LoadAsync(sfProperty::SPtr propPtr, const FString& path)
+{
+    AsyncLoad* loadPtr = m_asyncLoads.Find(path);
+    if (loadPtr != nullptr)
+    {
+        if (std::find(loadPtr->Properties.begin(), loadPtr->Properties.end(), propPtr) == loadPtr->Properties.end())
+        {
+            loadPtr->Properties.emplace_back(propPtr);
+        }
+        return;
+    }
+    m_asyncLoads.Add(path).Properties.emplace_back(propPtr);
+    m_numAsyncLoads++;
+    // The completion delegate can be called before RequestAsyncLoad returns if the asset is already loaded, so the
+    // load is added to the map first and the handle is set after.
+    TSharedPtr<FStreamableHandle> handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        FSoftObjectPath(path),
+        FStreamableDelegate::CreateRaw(this, &sfLoader::OnAsyncLoadComplete, path),
+        GetLoadPriority(propPtr->GetContainerObject()));
+    if (!handle.IsValid())
+    {
+        // The request failed and the delegate will not be called. Complete the load so the properties are applied,
+        // which loads the asset synchronously or falls back to a stand-in.
+        OnAsyncLoadComplete(path);
+        return;
+    }
+    loadPtr = m_asyncLoads.Find(path);
+    if (loadPtr != nullptr)
+    {
+        loadPtr->Handle = handle;
+    }
+}
+
+void sfLoader::OnAsyncLoadComplete(FString path)
+{
+    AsyncLoad load;
+    if (!m_asyncLoads.RemoveAndCopyValue(path, load))
+    {
+        return;
+    }
+    m_numAsyncLoadsCompleted++;
+    // Priorities are recalculated since the camera or selection may have changed while loading.
+    for (sfProperty::SPtr propPtr : load.Properties)
+    {
+        m_loadedProperties.HeapPush(LoadedProperty{ propPtr, GetLoadPriority(propPtr->GetContainerObject()) });
+    }
+}
+
+void sfLoader::ApplyLoadedAssets()
+{
+    if (m_loadedProperties.Num() == 0)
+    {
+        return;
+    }
+    double endTime = FPlatformTime::Seconds() + sfConfig::Get().AssetLoadBudget / 1000.0;
+    // Missing assets did not load. Loading them now creates stand-ins.
+    m_overrideIdle = true;
+    do
+    {
+        LoadedProperty loaded;
+        m_loadedProperties.HeapPop(loaded, false);
+        LoadProperty(loaded.Property);
+    } while (m_loadedProperties.Num() > 0 && FPlatformTime::Seconds() < endTime);
+    m_overrideIdle = false;
+}
+
+int sfLoader::GetLoadPriority(sfObject::SPtr objPtr)
+{
+    UObject* uobjPtr = sfObjectMap::GetUObject(objPtr);
+    AActor* actorPtr = Cast<AActor>(uobjPtr);
+    if (actorPtr == nullptr && uobjPtr != nullptr)
+    {
+        actorPtr = uobjPtr->GetTypedOuter<AActor>();
+    }
+    if (actorPtr == nullptr)
+    {
+        return 0;
+    }
+    int priority = actorPtr->IsSelected() ? SELECTED_PRIORITY : 0;
+    if (GCurrentLevelEditingViewportClient)
+    {
+        FVector offset = actorPtr->GetActorLocation() - GCurrentLevelEditingViewportClient->GetViewLocation();
+        if (!actorPtr->IsHiddenEd() &&
+            FVector::DotProduct(offset, GCurrentLevelEditingViewportClient->GetViewRotation().Vector()) >= 0.0f)
+        {
+            priority += VISIBLE_PRIORITY;
+        }
+        priority += MAX_DISTANCE_PRIORITY - FMath::Min(MAX_DISTANCE_PRIORITY, (int)(offset.Size() / 100.0f));
+    }
+    return priority;
+}
+
+void sfLoader::UpdateProgress()
+{
+    if (m_asyncLoads.Num() == 0 && m_loadedProperties.Num() == 0)
+    {
+        if (m_progressNotificationPtr.IsValid())
+        {
+            m_progressNotificationPtr->SetText(FText::FromString("Loaded " + FString::FromInt(m_numAsyncLoads) +
+                " asset(s)"));
+            m_progressNotificationPtr->SetCompletionState(SNotificationItem::CS_Success);
+            m_progressNotificationPtr->ExpireAndFadeout();
+            m_progressNotificationPtr = nullptr;
+        }
+        m_numAsyncLoads = 0;
+        m_numAsyncLoadsCompleted = 0;
+        if (m_numPrefetchBatches == 0)
+        {
+            // Prefetched assets are referenced by their objects now
+            m_prefetchHandles.Empty();
+        }
+        return;
+    }
+    FText text = FText::FromString("Loading assets (" + FString::FromInt(m_numAsyncLoadsCompleted) + "/" +
+        FString::FromInt(m_numAsyncLoads) + ")");
+    if (!m_progressNotificationPtr.IsValid())
+    {
+        FNotificationInfo info(text);
+        info.bFireAndForget = false;
+        info.bUseThrobber = true;
+        info.ExpireDuration = 2.0f;
+        m_progressNotificationPtr = FSlateNotificationManager::Get().AddNotification(info);
+        if (m_progressNotificationPtr.IsValid())
+        {
+            m_progressNotificationPtr->SetCompletionState(SNotificationItem::CS_Pending);
+        }
+    }
+    else
+    {
+        m_progressNotificationPtr->SetText(text);
     }
-    m_delayedAssets.clear();
 }
 
 void sfLoader::Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor)
@@ -374,10 +798,21 @@ void sfLoader::Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedR
         m_replaceTimer -= DeltaTime;
     }
 
-    if (IsUserIdle())
+    // Delayed assets are loaded a few at a time so input after the user becomes idle is handled on the next tick.
+    bool isIdle = IsUserIdle();
+    if (isIdle)
     {
+        if (!m_wasIdle)
+        {
+            // The camera and selection may have changed while the user was active
+            PrioritizeDelayedAssets();
+        }
         LoadDelayedAssets();
     }
+    m_wasIdle = isIdle;
+    ApplyLoadedAssets();
+    GenerateStandIns();
+    UpdateProgress();
 }
 
 bool sfLoader::HandleMouseButtonDownEvent(FSlateApplication& slateApp, const FPointerEvent& mouseEvent)
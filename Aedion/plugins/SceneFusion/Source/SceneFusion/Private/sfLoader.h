@@ -2,14 +2,20 @@
 
 #include "sfIStandInGenerator.h"
 #include <sfProperty.h>
+#include <sfValueProperty.h>
 #include <sfObject.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <set>
 #include <functional>
 #include <CoreMinimal.h>
 #include <IInputProcessor.h>
 #include <SlateApplication.h>
 #include <Engine/AssetManager.h>
+#include <Engine/StreamableManager.h>
+
+class SNotificationItem;
 
 using namespace KS;
 using namespace KS::SceneFusion2;
@@ -22,6 +28,51 @@ using namespace KS::SceneFusion2;
 class sfLoader : public IInputProcessor
 {
 public:
+    /**
+     * Counts of delayed asset properties loaded while the user was idle.
+     */
+    struct DelayedLoadStats
+    {
+    public:
+        /**
+         * Number of properties loaded.
+         */
+        int Loaded = 0;
+
+        /**
+         * Seconds spent loading.
+         */
+        double Seconds = 0.0;
+    };
+
+    /**
+     * Timeline of joining a session, broken down into time spent receiving objects, loading assets and spawning
+     * actors. The stages overlap so they do not add up to the total join time.
+     */
+    struct JoinStats
+    {
+    public:
+        /**
+         * Seconds from starting the loader to receiving the last prefetched object tree.
+         */
+        double Network = 0.0;
+
+        /**
+         * Seconds from the first prefetch request to the last prefetch batch finishing loading.
+         */
+        double IO = 0.0;
+
+        /**
+         * Seconds spent spawning actors and applying their properties.
+         */
+        double Apply = 0.0;
+
+        /**
+         * Number of assets prefetched.
+         */
+        int Assets = 0;
+    };
+
     /**
      * @return  sfLoader& singleton instance.
      */
@@ -57,6 +108,22 @@ public:
      */
     bool IsUserIdle();
 
+    /**
+     * Checks if assets should be loaded on the game thread now. This is true while loading assets that are needed
+     * immediately, or if async loading is disabled and the user is idle.
+     *
+     * @return  bool true if assets should be loaded now.
+     */
+    bool CanLoadNow();
+
+    /**
+     * Loads the asset for a property asynchronously and sets the reference to it once it is loaded. If async loading
+     * is disabled in the config, loads the asset when the user becomes idle.
+     *
+     * @param   sfProperty::SPtr propPtr to load asset for.
+     */
+    void LoadLater(sfProperty::SPtr propPtr);
+
     /**
      * Loads the asset for a property when the user becomes idle.
      *
@@ -64,6 +131,64 @@ public:
      */
     void LoadWhenIdle(sfProperty::SPtr propPtr);
 
+    /**
+     * Walks an object and its descendants once and starts loading every asset they reference that is not in memory
+     * in one asynchronous batch. Call this when an object tree is received, before spawning its actors, so loading
+     * overlaps with spawning. Does nothing if async loading or prefetching is disabled in the config.
+     *
+     * @param   sfObject::SPtr rootPtr of the object tree to prefetch assets for.
+     */
+    void Prefetch(sfObject::SPtr rootPtr);
+
+    /**
+     * Gets the join timeline. Assign a new JoinStats to reset it.
+     *
+     * @return  JoinStats&
+     */
+    JoinStats& GetJoinStats()
+    {
+        return m_joinStats;
+    }
+
+    /**
+     * Adds values in a property and its descendants that reference missing assets with stand-ins to the stand-in
+     * reference index, so they are updated when the asset becomes available. Call this for properties that are
+     * applied with or set to stand-ins.
+     *
+     * @param   sfProperty::SPtr propPtr to index.
+     */
+    void AddStandInReferences(sfProperty::SPtr propPtr);
+
+    /**
+     * Gets the number of objects with assets waiting to be loaded when the user is idle.
+     *
+     * @return  int
+     */
+    int GetDelayedQueueDepth()
+    {
+        return (int)m_delayedAssets.size();
+    }
+
+    /**
+     * Gets the number of assets being loaded asynchronously.
+     *
+     * @return  int
+     */
+    int GetAsyncQueueDepth()
+    {
+        return m_asyncLoads.Num();
+    }
+
+    /**
+     * Gets the counts of delayed asset properties loaded. Assign a new DelayedLoadStats to reset them.
+     *
+     * @return  DelayedLoadStats&
+     */
+    DelayedLoadStats& GetDelayedLoadStats()
+    {
+        return m_delayedLoadStats;
+    }
+
     /**
      * Loads delayed assets referenced by an object or its component children.
      *
@@ -126,20 +251,116 @@ public:
     virtual bool HandleMouseButtonUpEvent(FSlateApplication& slateApp, const FPointerEvent& mouseEvent) override;
 
 private:
+    /**
+     * An asset being loaded asynchronously.
+     */
+    struct AsyncLoad
+    {
+    public:
+        TSharedPtr<FStreamableHandle> Handle;
+        // Properties that reference the asset
+        std::vector<sfProperty::SPtr> Properties;
+    };
+
+    /**
+     * A stand-in whose data is waiting to be generated.
+     */
+    struct StandInToGenerate
+    {
+    public:
+        TWeakObjectPtr<UObject> StandIn;
+        FString Path;
+        TSharedPtr<sfIStandInGenerator> Generator;
+    };
+
+    /**
+     * A property whose asset finished loading and is waiting to be applied.
+     */
+    struct LoadedProperty
+    {
+    public:
+        sfProperty::SPtr Property;
+        int Priority;
+
+        /**
+         * Orders properties with higher priorities first in a TArray heap.
+         *
+         * @param   const LoadedProperty& other
+         * @return  bool
+         */
+        bool operator<(const LoadedProperty& other) const
+        {
+            return Priority > other.Priority;
+        }
+    };
+
+    /**
+     * An object with delayed assets to load when the user is idle.
+     */
+    struct DelayedObject
+    {
+    public:
+        sfObject::SPtr Object;
+        int Priority;
+
+        /**
+         * Orders objects with higher priorities first in a TArray heap.
+         *
+         * @param   const DelayedObject& other
+         * @return  bool
+         */
+        bool operator<(const DelayedObject& other) const
+        {
+            return Priority > other.Priority;
+        }
+    };
+
+    // Load priority added for selected objects
+    static const int SELECTED_PRIORITY = 2000000;
+    // Load priority added for objects in front of the camera
+    static const int VISIBLE_PRIORITY = 1000000;
+    // Load priority for objects at the camera. Priority decreases by one per meter from the camera.
+    static const int MAX_DISTANCE_PRIORITY = 999999;
+
+    typedef std::set<std::weak_ptr<sfValueProperty>, std::owner_less<std::weak_ptr<sfValueProperty>>> ValueSet;
+
     static TSharedPtr<sfLoader> m_instancePtr;
 
     // Maps objects to a list of their properties that referenced assets to be loaded when the user is idle.
     std::unordered_map<sfObject::SPtr, std::vector<sfProperty::SPtr>> m_delayedAssets;
+    // Heap of objects in m_delayedAssets. Objects whose assets were already loaded are skipped when popped.
+    TArray<DelayedObject> m_delayedObjects;
+    DelayedLoadStats m_delayedLoadStats;
     // Maps classes to the path to their stand-in asset. If a class is not in the map, a stand-in is created using
     // NewObject.
     TMap<UClass*, FString> m_standInPaths;
     TMap<UClass*, TSharedPtr<sfIStandInGenerator>> m_standInGenerators;
     // Maps missing asset paths to their stand-ins.
     TMap<FString, UObject*> m_standIns;
+    // Maps the string table ids of stand-in asset strings to the properties that reference them. Properties may have
+    // been removed or changed since they were added, so they are checked before they are used.
+    std::unordered_map<uint32_t, ValueSet> m_standInReferences;
     TArray<UObject*> m_standInsToReplace;
+    TArray<StandInToGenerate> m_standInsToGenerate;
+    TMap<FString, AsyncLoad> m_asyncLoads;// key: asset path
+    TArray<LoadedProperty> m_loadedProperties;// heap of properties to apply loaded assets to
+    int m_numAsyncLoads;// number of assets requested since there were no pending loads
+    int m_numAsyncLoadsCompleted;
+    TSharedPtr<SNotificationItem> m_progressNotificationPtr;
+    // Handles for prefetch batches. They keep the prefetched assets in memory until the loads that use them are
+    // applied.
+    TArray<TSharedPtr<FStreamableHandle>> m_prefetchHandles;
+    // String table ids of values checked by Prefetch
+    std::unordered_set<uint32_t> m_prefetchedIds;
+    int m_numPrefetchBatches;// number of prefetch batches still loading
+    int m_prefetchSession;// incremented when the loader stops so callbacks for old prefetch batches are ignored
+    double m_startTime;// time the loader was started
+    double m_prefetchStartTime;// time of the first prefetch request
+    JoinStats m_joinStats;
     float m_replaceTimer;
     bool m_isMouseDown;
     bool m_overrideIdle;// if true, IsUserIdle() returns true even if the user isn't idle
+    bool m_wasIdle;// was the user idle last tick?
     FDelegateHandle m_onNewAssetHandle;
 
     /**
@@ -148,10 +369,72 @@ private:
     void ReplaceStandIns();
 
     /**
-     * Loads delayed assets and sets references to them.
+     * Generates data for new stand-ins, oldest first, until the tick's time budget is used.
+     */
+    void GenerateStandIns();
+
+    /**
+     * Loads delayed assets and sets references to them, highest priority objects first, until the tick's time budget
+     * is used.
      */
     void LoadDelayedAssets();
 
+    /**
+     * Recalculates the priorities of objects with delayed assets.
+     */
+    void PrioritizeDelayedAssets();
+
+    /**
+     * Requests an asset to be loaded asynchronously for a property.
+     *
+     * @param   sfProperty::SPtr propPtr that references the asset.
+     * @param   const FString& path of asset to load.
+     */
+    void LoadAsync(sfProperty::SPtr propPtr, const FString& path);
+
+    /**
+     * Called when an asynchronous load completes. Queues the properties that reference the asset to be applied.
+     *
+     * @param   FString path of the asset that was loaded.
+     */
+    void OnAsyncLoadComplete(FString path);
+
+    /**
+     * Called when a prefetch batch finishes loading, is canceled, or fails to start. Logs the join timeline once all
+     * batches are done.
+     *
+     * @param   int session the batch was requested in. Batches from earlier sessions are ignored.
+     */
+    void OnPrefetchComplete(int session);
+
+    /**
+     * Finds a class that is in memory without loading it.
+     *
+     * @param   const FString& className - class name, or blueprint path for blueprint classes.
+     * @return  UClass* class, or nullptr if it is not in memory.
+     */
+    UClass* FindClass(const FString& className);
+
+    /**
+     * Applies loaded assets to the properties that reference them, highest priority first, until the tick's time
+     * budget is used.
+     */
+    void ApplyLoadedAssets();
+
+    /**
+     * Gets the load priority for assets referenced by an object. Selected objects, objects in front of the camera,
+     * and objects closer to the camera have higher priorities.
+     *
+     * @param   sfObject::SPtr objPtr
+     * @return  int
+     */
+    int GetLoadPriority(sfObject::SPtr objPtr);
+
+    /**
+     * Shows, updates or hides the asset loading progress notification.
+     */
+    void UpdateProgress();
+
     /**
      * Loads the asset for a property and sets the reference to it.
      *
@@ -1,19 +1,26 @@
 #include  "sfObjectMap.h"
 #include "Consts.h"
+#include "sfPropertyUtil.h"
 #include <sfDictionaryProperty.h>
 #include <GameFramework/Actor.h>
+#include <Engine/Level.h>
 
-TMap<const UObject*, sfObject::SPtr> sfObjectMap::m_uToSFObjectMap;
-std::unordered_map<sfObject::SPtr, UObject*> sfObjectMap::m_sfToUObjectMap;
+std::vector<sfObjectMap::Entry> sfObjectMap::m_entries;
+std::vector<sfObjectMap::Slot> sfObjectMap::m_slots;
+uint32_t sfObjectMap::m_freeSlot = sfObjectMap::INVALID_SLOT;
+std::vector<uint32_t> sfObjectMap::m_idIndex;
+std::vector<uint32_t> sfObjectMap::m_uobjectIndex;
+std::vector<sfObjectMap::TypePartition> sfObjectMap::m_typePartitions;
+TMap<const ULevel*, std::vector<uint32_t>> sfObjectMap::m_levelPartitions;
 
 bool sfObjectMap::Contains(const UObject* uobjPtr)
 {
-    return uobjPtr != nullptr && m_uToSFObjectMap.Contains(uobjPtr);
+    return uobjPtr != nullptr && FindUObject(uobjPtr) != INVALID_SLOT;
 }
 
-bool sfObjectMap::Contains(const sfObject::SPtr objPtr)
+bool sfObjectMap::Contains(const sfObject::SPtr& objPtr)
 {
-    return objPtr != nullptr && m_sfToUObjectMap.find(objPtr) != m_sfToUObjectMap.end();
+    return objPtr != nullptr && FindObject(objPtr.get()) != INVALID_SLOT;
 }
 
 sfObject::SPtr sfObjectMap::GetSFObject(const UObject* uobjPtr)
@@ -22,7 +29,8 @@ sfObject::SPtr sfObjectMap::GetSFObject(const UObject* uobjPtr)
     {
         return nullptr;
     }
-    return m_uToSFObjectMap.FindRef(uobjPtr);
+    uint32_t bucket = FindUObject(uobjPtr);
+    return bucket == INVALID_SLOT ? nullptr : m_entries[m_slots[m_uobjectIndex[bucket]].EntryIndex].Object;
 }
 
 sfObject::SPtr sfObjectMap::GetOrCreateSFObject(UObject* uobjPtr, const sfName& type)
@@ -31,24 +39,45 @@ sfObject::SPtr sfObjectMap::GetOrCreateSFObject(UObject* uobjPtr, const sfName&
     {
         return nullptr;
     }
-    sfObject::SPtr objPtr = m_uToSFObjectMap.FindRef(uobjPtr);
-    if (objPtr != nullptr)
+    uint32_t bucket = FindUObject(uobjPtr);
+    if (bucket != INVALID_SLOT)
     {
-        return objPtr;
+        return m_entries[m_slots[m_uobjectIndex[bucket]].EntryIndex].Object;
     }
-    objPtr = sfObject::Create(type, sfDictionaryProperty::Create());
+    sfObject::SPtr objPtr = sfObject::Create(type, sfDictionaryProperty::Create());
     Add(objPtr, uobjPtr);
     return objPtr;
 }
 
-UObject* sfObjectMap::GetUObject(sfObject::SPtr objPtr)
+UObject* sfObjectMap::GetUObject(const sfObject::SPtr& objPtr)
 {
     if (objPtr == nullptr)
     {
         return nullptr;
     }
-    auto iter = m_sfToUObjectMap.find(objPtr);
-    return iter == m_sfToUObjectMap.end() ? nullptr : iter->second;
+    uint32_t bucket = FindObject(objPtr.get());
+    return bucket == INVALID_SLOT ? nullptr : m_entries[m_slots[m_idIndex[bucket]].EntryIndex].UObjectPtr;
+}
+
+sfObjectMap::Handle sfObjectMap::GetHandle(const sfObject::SPtr& objPtr)
+{
+    Handle handle;
+    uint32_t bucket = objPtr == nullptr ? INVALID_SLOT : FindObject(objPtr.get());
+    if (bucket != INVALID_SLOT)
+    {
+        handle.Slot = m_idIndex[bucket];
+        handle.Generation = m_slots[handle.Slot].Generation;
+    }
+    return handle;
+}
+
+UObject* sfObjectMap::GetUObject(const Handle& handle)
+{
+    if (handle.Slot >= m_slots.size() || m_slots[handle.Slot].Generation != handle.Generation)
+    {
+        return nullptr;
+    }
+    return m_entries[m_slots[handle.Slot].EntryIndex].UObjectPtr;
 }
 
 void sfObjectMap::Add(sfObject::SPtr objPtr, UObject* uobjPtr)
@@ -57,8 +86,37 @@ void sfObjectMap::Add(sfObject::SPtr objPtr, UObject* uobjPtr)
     {
         return;
     }
-    m_sfToUObjectMap[objPtr] = uobjPtr;
-    m_uToSFObjectMap.Add(uobjPtr, objPtr);
+    uint32_t bucket = FindObject(objPtr.get());
+    if (bucket != INVALID_SLOT)
+    {
+        uint32_t slot = m_idIndex[bucket];
+        if (m_entries[m_slots[slot].EntryIndex].UObjectPtr == uobjPtr)
+        {
+            return;
+        }
+        RemoveSlot(slot);
+    }
+    bucket = FindUObject(uobjPtr);
+    if (bucket != INVALID_SLOT)
+    {
+        RemoveSlot(m_uobjectIndex[bucket]);
+    }
+    Reserve();
+    uint32_t slot = m_freeSlot;
+    if (slot != INVALID_SLOT)
+    {
+        m_freeSlot = m_slots[slot].EntryIndex;
+    }
+    else
+    {
+        slot = (uint32_t)m_slots.size();
+        m_slots.push_back(Slot{ 0, 0 });
+    }
+    m_slots[slot].EntryIndex = (uint32_t)m_entries.size();
+    m_entries.push_back(Entry{ std::move(objPtr), uobjPtr, slot, 0, 0, nullptr, 0 });
+    Insert(m_idIndex, GetIdHash(slot), slot);
+    Insert(m_uobjectIndex, GetUObjectHash(slot), slot);
+    AddToPartitions(slot);
 }
 
 sfObject::SPtr sfObjectMap::Remove(const UObject* uobjPtr)
@@ -67,43 +125,289 @@ sfObject::SPtr sfObjectMap::Remove(const UObject* uobjPtr)
     {
         return nullptr;
     }
-    sfObject::SPtr objPtr = nullptr;
-    if (m_uToSFObjectMap.RemoveAndCopyValue(uobjPtr, objPtr))
+    uint32_t bucket = FindUObject(uobjPtr);
+    if (bucket == INVALID_SLOT)
     {
-        m_sfToUObjectMap.erase(objPtr);
+        return nullptr;
     }
+    uint32_t slot = m_uobjectIndex[bucket];
+    sfObject::SPtr objPtr = m_entries[m_slots[slot].EntryIndex].Object;
+    RemoveSlot(slot);
     return objPtr;
 }
 
-UObject* sfObjectMap::Remove(sfObject::SPtr objPtr)
+UObject* sfObjectMap::Remove(const sfObject::SPtr& objPtr)
 {
     if (objPtr == nullptr)
     {
         return nullptr;
     }
-    auto iter = m_sfToUObjectMap.find(objPtr);
-    if (iter == m_sfToUObjectMap.end())
+    uint32_t bucket = FindObject(objPtr.get());
+    if (bucket == INVALID_SLOT)
     {
         return nullptr;
     }
-    UObject* uobjPtr = iter->second;
-    m_sfToUObjectMap.erase(iter);
-    m_uToSFObjectMap.Remove(uobjPtr);
+    uint32_t slot = m_idIndex[bucket];
+    UObject* uobjPtr = m_entries[m_slots[slot].EntryIndex].UObjectPtr;
+    RemoveSlot(slot);
     return uobjPtr;
 }
 
 void sfObjectMap::Clear()
 {
-    m_uToSFObjectMap.Empty();
-    m_sfToUObjectMap.clear();
+    // Slots are kept so handles to removed mappings stay invalid when the slots are reused.
+    for (const Entry& entry : m_entries)
+    {
+        sfPropertyUtil::ClearContentHashes(entry.UObjectPtr);
+        Slot& slot = m_slots[entry.Slot];
+        slot.Generation++;
+        slot.EntryIndex = m_freeSlot;
+        m_freeSlot = entry.Slot;
+    }
+    std::vector<Entry>().swap(m_entries);
+    std::vector<uint32_t>().swap(m_idIndex);
+    std::vector<uint32_t>().swap(m_uobjectIndex);
+    m_typePartitions.clear();
+    m_levelPartitions.Empty();
+}
+
+int sfObjectMap::Num()
+{
+    return (int)m_entries.size();
 }
 
-std::unordered_map<sfObject::SPtr, UObject*>::iterator sfObjectMap::Begin()
+void sfObjectMap::ForEach(std::function<void(const sfObject::SPtr&, UObject*)> callback)
 {
-    return m_sfToUObjectMap.begin();
+    for (const Entry& entry : m_entries)
+    {
+        callback(entry.Object, entry.UObjectPtr);
+    }
 }
 
-std::unordered_map<sfObject::SPtr, UObject*>::iterator sfObjectMap::End()
+void sfObjectMap::ForEachOfType(const sfName& type, std::function<void(const sfObject::SPtr&, UObject*)> callback)
 {
-    return m_sfToUObjectMap.end();
-}
\ No newline at end of file
+    for (const TypePartition& partition : m_typePartitions)
+    {
+        if (partition.Type == type)
+        {
+            for (uint32_t slot : partition.Slots)
+            {
+                const Entry& entry = m_entries[m_slots[slot].EntryIndex];
+                callback(entry.Object, entry.UObjectPtr);
+            }
+            return;
+        }
+    }
+}
+
+void sfObjectMap::ForEachInLevel(
+    const ULevel* levelPtr,
+    std::function<void(const sfObject::SPtr&, UObject*)> callback)
+{
+    std::vector<uint32_t>* slotsPtr = m_levelPartitions.Find(levelPtr);
+    if (slotsPtr == nullptr)
+    {
+        return;
+    }
+    for (uint32_t slot : *slotsPtr)
+    {
+        const Entry& entry = m_entries[m_slots[slot].EntryIndex];
+        callback(entry.Object, entry.UObjectPtr);
+    }
+}
+
+void sfObjectMap::RemoveLevel(const ULevel* levelPtr)
+{
+    // The partition is removed from the level partitions when its last slot is removed.
+    std::vector<uint32_t>* slotsPtr;
+    while (levelPtr != nullptr && (slotsPtr = m_levelPartitions.Find(levelPtr)) != nullptr)
+    {
+        RemoveSlot(slotsPtr->back());
+    }
+}
+
+uint32_t sfObjectMap::FindObject(const sfObject* objPtr)
+{
+    if (m_idIndex.empty())
+    {
+        return INVALID_SLOT;
+    }
+    size_t mask = m_idIndex.size() - 1;
+    for (size_t bucket = Hash(objPtr->Id()) & mask; m_idIndex[bucket] != INVALID_SLOT; bucket = (bucket + 1) & mask)
+    {
+        // Ids are only used to find the bucket. Compare pointers in case different objects have the same id.
+        if (m_entries[m_slots[m_idIndex[bucket]].EntryIndex].Object.get() == objPtr)
+        {
+            return (uint32_t)bucket;
+        }
+    }
+    return INVALID_SLOT;
+}
+
+uint32_t sfObjectMap::FindUObject(const UObject* uobjPtr)
+{
+    if (m_uobjectIndex.empty())
+    {
+        return INVALID_SLOT;
+    }
+    size_t mask = m_uobjectIndex.size() - 1;
+    for (size_t bucket = Hash((UPTRINT)uobjPtr) & mask; m_uobjectIndex[bucket] != INVALID_SLOT;
+        bucket = (bucket + 1) & mask)
+    {
+        if (m_entries[m_slots[m_uobjectIndex[bucket]].EntryIndex].UObjectPtr == uobjPtr)
+        {
+            return (uint32_t)bucket;
+        }
+    }
+    return INVALID_SLOT;
+}
+
+void sfObjectMap::RemoveSlot(uint32_t slot)
+{
+    // Remove from the indexes before moving entries since the hashes are read from the entries.
+    Erase(m_idIndex, slot, &GetIdHash);
+    Erase(m_uobjectIndex, slot, &GetUObjectHash);
+    RemoveFromPartitions(slot);
+    // The object no longer syncs, and its address may be reused by an object the hashes don't belong to.
+    uint32_t entry = m_slots[slot].EntryIndex;
+    sfPropertyUtil::ClearContentHashes(m_entries[entry].UObjectPtr);
+    // Move the last entry into the removed entry's place to keep the entries dense.
+    if (entry != m_entries.size() - 1)
+    {
+        m_entries[entry] = std::move(m_entries.back());
+        m_slots[m_entries[entry].Slot].EntryIndex = entry;
+    }
+    m_entries.pop_back();
+    m_slots[slot].EntryIndex = m_freeSlot;
+    m_slots[slot].Generation++;
+    m_freeSlot = slot;
+}
+
+void sfObjectMap::AddToPartitions(uint32_t slot)
+{
+    Entry& entry = m_entries[m_slots[slot].EntryIndex];
+    const sfName& type = entry.Object->Type();
+    entry.TypeIndex = 0;
+    while (entry.TypeIndex < m_typePartitions.size() && m_typePartitions[entry.TypeIndex].Type != type)
+    {
+        entry.TypeIndex++;
+    }
+    if (entry.TypeIndex == m_typePartitions.size())
+    {
+        m_typePartitions.push_back(TypePartition{ type });
+    }
+    std::vector<uint32_t>& typeSlots = m_typePartitions[entry.TypeIndex].Slots;
+    entry.TypePosition = (uint32_t)typeSlots.size();
+    typeSlots.push_back(slot);
+
+    // Only actors and components are in levels. Other uobjects are not dereferenced.
+    if (type == sfType::Actor || type == sfType::Component)
+    {
+        entry.LevelPtr = entry.UObjectPtr->GetTypedOuter<ULevel>();
+    }
+    if (entry.LevelPtr != nullptr)
+    {
+        std::vector<uint32_t>& levelSlots = m_levelPartitions.FindOrAdd(entry.LevelPtr);
+        entry.LevelPosition = (uint32_t)levelSlots.size();
+        levelSlots.push_back(slot);
+    }
+}
+
+void sfObjectMap::RemoveFromPartitions(uint32_t slot)
+{
+    const Entry& entry = m_entries[m_slots[slot].EntryIndex];
+    // Move the last slot in each partition into the removed slot's position.
+    std::vector<uint32_t>& typeSlots = m_typePartitions[entry.TypeIndex].Slots;
+    uint32_t position = entry.TypePosition;
+    typeSlots[position] = typeSlots.back();
+    m_entries[m_slots[typeSlots[position]].EntryIndex].TypePosition = position;
+    typeSlots.pop_back();
+
+    if (entry.LevelPtr != nullptr)
+    {
+        std::vector<uint32_t>& levelSlots = m_levelPartitions.FindChecked(entry.LevelPtr);
+        position = entry.LevelPosition;
+        levelSlots[position] = levelSlots.back();
+        m_entries[m_slots[levelSlots[position]].EntryIndex].LevelPosition = position;
+        levelSlots.pop_back();
+        if (levelSlots.empty())
+        {
+            m_levelPartitions.Remove(entry.LevelPtr);
+        }
+    }
+}
+
+void sfObjectMap::Insert(std::vector<uint32_t>& index, size_t hash, uint32_t slot)
+{
+    size_t mask = index.size() - 1;
+    size_t bucket = hash & mask;
+    while (index[bucket] != INVALID_SLOT)
+    {
+        bucket = (bucket + 1) & mask;
+    }
+    index[bucket] = slot;
+}
+
+void sfObjectMap::Erase(std::vector<uint32_t>& index, uint32_t slot, size_t (*getHash)(uint32_t))
+{
+    size_t mask = index.size() - 1;
+    size_t bucket = getHash(slot) & mask;
+    while (index[bucket] != slot)
+    {
+        bucket = (bucket + 1) & mask;
+    }
+    // Move later slots in the probe sequence into the hole if the hole is between their home bucket and their
+    // current bucket.
+    size_t next = bucket;
+    while (true)
+    {
+        next = (next + 1) & mask;
+        if (index[next] == INVALID_SLOT)
+        {
+            break;
+        }
+        size_t home = getHash(index[next]) & mask;
+        if (((next - home) & mask) >= ((next - bucket) & mask))
+        {
+            index[bucket] = index[next];
+            bucket = next;
+        }
+    }
+    index[bucket] = INVALID_SLOT;
+}
+
+void sfObjectMap::Reserve()
+{
+    if ((m_entries.size() + 1) * 2 <= m_idIndex.size())
+    {
+        return;
+    }
+    size_t size = FMath::Max((size_t)64, m_idIndex.size() * 2);
+    m_idIndex.assign(size, (uint32_t)INVALID_SLOT);
+    m_uobjectIndex.assign(size, (uint32_t)INVALID_SLOT);
+    for (const Entry& entry : m_entries)
+    {
+        Insert(m_idIndex, GetIdHash(entry.Slot), entry.Slot);
+        Insert(m_uobjectIndex, GetUObjectHash(entry.Slot), entry.Slot);
+    }
+}
+
+size_t sfObjectMap::GetIdHash(uint32_t slot)
+{
+    return Hash(m_entries[m_slots[slot].EntryIndex].Object->Id());
+}
+
+size_t sfObjectMap::GetUObjectHash(uint32_t slot)
+{
+    return Hash((UPTRINT)m_entries[m_slots[slot].EntryIndex].UObjectPtr);
+}
+
+size_t sfObjectMap::Hash(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return (size_t)key;
+}
@@ -2,16 +2,33 @@
 
 #include <sfObject.h>
 #include <CoreMinimal.h>
-#include <unordered_map>
+#include <vector>
+#include <functional>
+
+class ULevel;
 
 using namespace KS::SceneFusion2;
 
 /**
- * Maps sfObjects to uobjects and vice versa.
+ * Maps sfObjects to uobjects and vice versa. Mappings are stored densely in a slot map and found through two
+ * open-addressing indexes, one keyed by sfObject id and one keyed by uobject pointer. Lookups do not copy shared
+ * pointers. Mappings are also partitioned by sfObject type, and actor and component mappings by level, so they can be
+ * iterated without scanning the whole map.
  */
 class sfObjectMap
 {
 public:
+    /**
+     * Generational handle to a mapping. A handle becomes invalid when its mapping is removed, even if the slot is
+     * reused by another mapping.
+     */
+    struct Handle
+    {
+    public:
+        uint32_t Slot = INVALID_SLOT;
+        uint32_t Generation = 0;
+    };
+
     /**
      * Checks if a uobject is in the map.
      *
@@ -23,10 +40,10 @@ public:
     /**
      * Checks if an sfObject is in the map.
      *
-     * @param   sfObject::SPtr objPtr
+     * @param   const sfObject::SPtr& objPtr
      * @return  bool true if the object is in the map.
      */
-    static bool Contains(sfObject::SPtr objPtr);
+    static bool Contains(const sfObject::SPtr& objPtr);
     
     /**
      * Gets the sfObject for a uobject, or nullptr if the uobject has no sfObject.
@@ -49,13 +66,30 @@ public:
     /**
      * Gets the uobject for an sfObject, or nullptr if the sfObject has no uobject.
      *
-     * @param   sfObject::SPtr objPtr to get uobject for.
+     * @param   const sfObject::SPtr& objPtr to get uobject for.
      * @return  UObject* uobject for the sfObject.
      */
-    static UObject* GetUObject(sfObject::SPtr objPtr);
+    static UObject* GetUObject(const sfObject::SPtr& objPtr);
 
     /**
-     * Adds a mapping between a uobject and an sfObject.
+     * Gets a handle to the mapping for an sfObject. Use handles to look up the same mapping repeatedly without
+     * searching.
+     *
+     * @param   const sfObject::SPtr& objPtr
+     * @return  Handle to the mapping. Invalid if the sfObject is not in the map.
+     */
+    static Handle GetHandle(const sfObject::SPtr& objPtr);
+
+    /**
+     * Gets the uobject for a handle.
+     *
+     * @param   const Handle& handle
+     * @return  UObject* uobject for the handle, or nullptr if the handle is invalid.
+     */
+    static UObject* GetUObject(const Handle& handle);
+
+    /**
+     * Adds a mapping between a uobject and an sfObject. Replaces any existing mappings for either of them.
      *
      * @param   sfObject::SPtr objPtr
      * @param   UObject* uobjPtr
@@ -73,10 +107,10 @@ public:
     /**
      * Removes an sfObject and its uobject from the map.
      *
-     * @param   sfObject::SPtr objPtr to remove.
+     * @param   const sfObject::SPtr& objPtr to remove.
      * @return  UObject* that was removed, or nullptr if the sfObject was not in the map.
      */
-    static UObject* Remove(sfObject::SPtr objPtr);
+    static UObject* Remove(const sfObject::SPtr& objPtr);
 
     /**
      * Clears the map.
@@ -84,28 +118,181 @@ public:
     static void Clear();
 
     /**
-     * @return  std::unordered_map<sfObject::SPtr, UObject*>::iterator pointing to the first pair in the map.
+     * @return  int number of mappings.
+     */
+    static int Num();
+
+    /**
+     * Calls a function on every mapping. The map must not be changed during iteration.
+     *
+     * @param   std::function<void(const sfObject::SPtr&, UObject*)> callback
      */
-    static std::unordered_map<sfObject::SPtr, UObject*>::iterator Begin();
+    static void ForEach(std::function<void(const sfObject::SPtr&, UObject*)> callback);
 
     /**
-     * @return  std::unordered_map<sfObject::SPtr, UObject*>::iterator pointing past the last pair in the map.
+     * Calls a function on every mapping for sfObjects of a type. The map must not be changed during iteration.
+     *
+     * @param   const sfName& type of sfObjects to iterate.
+     * @param   std::function<void(const sfObject::SPtr&, UObject*)> callback
      */
-    static std::unordered_map<sfObject::SPtr, UObject*>::iterator End();
+    static void ForEachOfType(const sfName& type, std::function<void(const sfObject::SPtr&, UObject*)> callback);
+
+    /**
+     * Calls a function on every actor and component mapping in a level. The map must not be changed during
+     * iteration.
+     *
+     * @param   const ULevel* levelPtr to iterate mappings in.
+     * @param   std::function<void(const sfObject::SPtr&, UObject*)> callback
+     */
+    static void ForEachInLevel(const ULevel* levelPtr, std::function<void(const sfObject::SPtr&, UObject*)> callback);
+
+    /**
+     * Removes every actor and component mapping in a level.
+     *
+     * @param   const ULevel* levelPtr to remove mappings for.
+     */
+    static void RemoveLevel(const ULevel* levelPtr);
 
     /**
      * Gets the uobject for an sfObject cast to T*.
      *
-     * @param   const sfObject::SPtr objPtr
+     * @param   const sfObject::SPtr& objPtr
      * @return  T* uobject for the sfObject, or nullptr not found or not of type T.
      */
     template<typename T>
-    static T* Get(const sfObject::SPtr objPtr)
+    static T* Get(const sfObject::SPtr& objPtr)
     {
         return Cast<T>(GetUObject(objPtr));
     }
 
 private:
-    static TMap<const UObject*, sfObject::SPtr> m_uToSFObjectMap;
-    static std::unordered_map<sfObject::SPtr, UObject*> m_sfToUObjectMap;
-};
\ No newline at end of file
+    static const uint32_t INVALID_SLOT = 0xFFFFFFFF;
+
+    /**
+     * A mapping in the dense array.
+     */
+    struct Entry
+    {
+    public:
+        sfObject::SPtr Object;
+        UObject* UObjectPtr;
+        uint32_t Slot;// index of the slot pointing to this entry
+        uint32_t TypeIndex;// index of the type partition
+        uint32_t TypePosition;// index in the type partition
+        const ULevel* LevelPtr;// level of the actor or component, or nullptr if not partitioned by level
+        uint32_t LevelPosition;// index in the level partition
+    };
+
+    /**
+     * Slots of the mappings for sfObjects of one type.
+     */
+    struct TypePartition
+    {
+    public:
+        sfName Type;
+        std::vector<uint32_t> Slots;
+    };
+
+    /**
+     * Points to an entry in the dense array. Slots keep their index when entries move, so indexes and handles refer
+     * to slots.
+     */
+    struct Slot
+    {
+    public:
+        uint32_t EntryIndex;// index of the entry, or the next free slot if the slot is free
+        uint32_t Generation;// incremented when the slot is freed
+    };
+
+    static std::vector<Entry> m_entries;
+    static std::vector<Slot> m_slots;
+    static uint32_t m_freeSlot;// first free slot, or INVALID_SLOT if there are no free slots
+    // Open-addressing hash tables with linear probing. Values are slot indexes, or INVALID_SLOT for empty buckets.
+    static std::vector<uint32_t> m_idIndex;// hashed by sfObject id
+    static std::vector<uint32_t> m_uobjectIndex;// hashed by uobject pointer
+    // Partitions store slot indexes in no particular order and are updated by swapping with the last slot on removal.
+    // There are only a few types, so type partitions are found by linear search.
+    static std::vector<TypePartition> m_typePartitions;
+    static TMap<const ULevel*, std::vector<uint32_t>> m_levelPartitions;
+
+    /**
+     * Finds the slot for an sfObject.
+     *
+     * @param   const sfObject* objPtr
+     * @return  uint32_t index into m_idIndex, or INVALID_SLOT if the sfObject is not in the map.
+     */
+    static uint32_t FindObject(const sfObject* objPtr);
+
+    /**
+     * Finds the slot for a uobject.
+     *
+     * @param   const UObject* uobjPtr
+     * @return  uint32_t index into m_uobjectIndex, or INVALID_SLOT if the uobject is not in the map.
+     */
+    static uint32_t FindUObject(const UObject* uobjPtr);
+
+    /**
+     * Removes the mapping in a slot.
+     *
+     * @param   uint32_t slot
+     */
+    static void RemoveSlot(uint32_t slot);
+
+    /**
+     * Adds a slot to the partitions for its entry.
+     *
+     * @param   uint32_t slot
+     */
+    static void AddToPartitions(uint32_t slot);
+
+    /**
+     * Removes a slot from the partitions for its entry.
+     *
+     * @param   uint32_t slot
+     */
+    static void RemoveFromPartitions(uint32_t slot);
+
+    /**
+     * Inserts a slot into an index. The index must have an empty bucket.
+     *
+     * @param   std::vector<uint32_t>& index
+     * @param   size_t hash of the slot's key.
+     * @param   uint32_t slot
+     */
+    static void Insert(std::vector<uint32_t>& index, size_t hash, uint32_t slot);
+
+    /**
+     * Removes a slot from an index, shifting back later entries in the probe sequence so lookups do not
+     * need tombstones.
+     *
+     * @param   std::vector<uint32_t>& index
+     * @param   uint32_t slot to remove.
+     * @param   size_t (*getHash)(uint32_t) gets the hash of a slot's key.
+     */
+    static void Erase(std::vector<uint32_t>& index, uint32_t slot, size_t (*getHash)(uint32_t));
+
+    /**
+     * Doubles the size of the indexes if adding a mapping would make them more than half full.
+     */
+    static void Reserve();
+
+    /**
+     * @param   uint32_t slot
+     * @return  size_t hash of the id of the sfObject in a slot.
+     */
+    static size_t GetIdHash(uint32_t slot);
+
+    /**
+     * @param   uint32_t slot
+     * @return  size_t hash of the uobject in a slot.
+     */
+    static size_t GetUObjectHash(uint32_t slot);
+
+    /**
+     * Mixes the bits of a key so nearby keys are spread across the index.
+     *
+     * @param   uint64_t key
+     * @return  size_t
+     */
+    static size_t Hash(uint64_t key);
+};
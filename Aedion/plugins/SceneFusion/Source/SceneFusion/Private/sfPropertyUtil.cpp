@@ -4,25 +4,58 @@
 #include "sfObjectMap.h"
 #include "Consts.h"
 #include "sfLoader.h"
+#include "sfStandInCache.h"
 #include "sfUtils.h"
+#include "sfConfig.h"
+#include "sfTransformCodec.h"
 
 #include <UnrealType.h>
 #include <EnumProperty.h>
 #include <TextProperty.h>
 #include <CoreRedirects.h>
+#include <Components/SceneComponent.h>
 
 #define LOG_CHANNEL "sfPropertyUtil"
 
-std::unordered_map<int, sfPropertyUtil::TypeHandler> sfPropertyUtil::m_typeHandlers;
+sfPropertyUtil::TypeHandler sfPropertyUtil::m_typeHandlers[sfPropertyUtil::NUM_TYPE_TAGS];
+bool sfPropertyUtil::m_initialized = false;
 TMap<FScriptMap*, TSharedPtr<FScriptMapHelper>> sfPropertyUtil::m_staleMaps;
 TMap<FScriptSet*, TSharedPtr<FScriptSetHelper>> sfPropertyUtil::m_staleSets;
-TSet<TPair<UObject*, UProperty*>> sfPropertyUtil::m_serverChangedProperties;
-TSet<TPair<UObject*, UProperty*>> sfPropertyUtil::m_localChangedProperties;
+TMap<const void*, TArray<int32>> sfPropertyUtil::m_sparseIndexes;
+TMap<UObject*, TArray<UProperty*>> sfPropertyUtil::m_serverChangedProperties;
+sfPropertyUtil::ChangeEventStats sfPropertyUtil::m_changeEventStats;
+TMap<TPair<UObject*, UProperty*>, bool> sfPropertyUtil::m_localChangedProperties;
+TMap<TPair<UObject*, UProperty*>, double> sfPropertyUtil::m_throttleTimes;
+TMap<TPair<UObject*, UProperty*>, TWeakObjectPtr<UObject>> sfPropertyUtil::m_deferredProperties;
+TMap<FName, float> sfPropertyUtil::m_classSyncIntervals;
+TMap<TPair<FName, FName>, float> sfPropertyUtil::m_propertySyncIntervals;
+sfPropertyUtil::ThrottleStats sfPropertyUtil::m_throttleStats;
 FDelegateHandle sfPropertyUtil::m_onPropertyChangeHandle;
 TSet<TPair<FName, FName>> sfPropertyUtil::m_forceSyncList;
 TMap<FName, sfPropertyUtil::PropertyChangeHandler> sfPropertyUtil::m_classNameToPropertyChangeHandler;
 TSet<FName> sfPropertyUtil::m_syncDefaultOnlyList;
+TSet<FName> sfPropertyUtil::m_blittableStructs;
 sfPropertyUtil::OnGetAssetPropertyEvent sfPropertyUtil::m_onGetAssetProperty;
+std::unordered_map<const UClass*, sfPropertyUtil::SyncPlan> sfPropertyUtil::m_syncPlans;
+std::unordered_map<const UClass*, sfPropertyUtil::PathCache> sfPropertyUtil::m_pathCaches;
+std::unordered_map<const UClass*, sfPropertyUtil::Schema> sfPropertyUtil::m_schemas;
+std::unordered_map<uint32_t, sfPropertyUtil::ResolvedSchema> sfPropertyUtil::m_resolvedSchemas;
+std::unordered_map<const UClass*, sfPropertyUtil::Template> sfPropertyUtil::m_templates;
+std::vector<sfObject::SPtr> sfPropertyUtil::m_templateObjects;
+TSet<uint32_t> sfPropertyUtil::m_missingSchemas;
+sfPropertyUtil::TemplateStats sfPropertyUtil::m_templateStats;
+TMap<FString, int> sfPropertyUtil::m_schemaVersions;
+UProperty* sfPropertyUtil::m_locationPropPtr = nullptr;
+UProperty* sfPropertyUtil::m_rotationPropPtr = nullptr;
+UProperty* sfPropertyUtil::m_scalePropPtr = nullptr;
+TMap<TPair<UClass*, FName>, TWeakObjectPtr<UObject>> sfPropertyUtil::m_defaultSubobjects;
+sfPropertyUtil::ListDiffStats sfPropertyUtil::m_listDiffStats;
+TMap<UObject*, sfPropertyUtil::ContentHashes> sfPropertyUtil::m_contentHashes;
+sfPropertyUtil::ContentHashStats sfPropertyUtil::m_contentHashStats;
+TMap<FString, uint32_t, FDefaultSetAllocator, sfPropertyUtil::CaseSensitiveStringKeyFuncs> sfPropertyUtil::m_stringIds;
+TMap<uint64, uint32_t> sfPropertyUtil::m_nameIds;
+TMap<uint32_t, FString> sfPropertyUtil::m_idStrings;
+int sfPropertyUtil::m_stringCacheBytes = 0;
 
 using namespace KS;
 
@@ -33,11 +66,46 @@ sfValueProperty::SPtr sfPropertyUtil::FromString(const FString& value)
         KS::Log::Error("Cannot convert string to property; session is nullptr", LOG_CHANNEL);
         return sfValueProperty::Create(0);
     }
-    std::string str = TCHAR_TO_UTF8(*value);
-    uint32_t id = SceneFusion::Service->Session()->GetStringTableId(str);
+    return sfValueProperty::Create(GetStringTableId(value));
+}
+
+sfValueProperty::SPtr sfPropertyUtil::FromName(const FName& value)
+{
+    if (SceneFusion::Service->Session() == nullptr)
+    {
+        KS::Log::Error("Cannot convert name to property; session is nullptr", LOG_CHANNEL);
+        return sfValueProperty::Create(0);
+    }
+    // The display index is unique for each case of a name, while the comparison index is not
+    uint64 key = ((uint64)value.GetDisplayIndex() << 32) | (uint32)value.GetNumber();
+    uint32_t* idPtr = m_nameIds.Find(key);
+    if (idPtr != nullptr)
+    {
+        return sfValueProperty::Create(*idPtr);
+    }
+    uint32_t id = GetStringTableId(value.ToString());
+    int bytes = sizeof(key) + sizeof(id);
+    if (m_stringCacheBytes + bytes > MAX_STRING_CACHE_BYTES)
+    {
+        ClearStringCache();
+    }
+    m_nameIds.Add(key, id);
+    m_stringCacheBytes += bytes;
     return sfValueProperty::Create(id);
 }
 
+uint32_t sfPropertyUtil::GetStringTableId(const FString& value)
+{
+    uint32_t* idPtr = m_stringIds.Find(value);
+    if (idPtr != nullptr)
+    {
+        return *idPtr;
+    }
+    uint32_t id = SceneFusion::Service->Session()->GetStringTableId(std::string(TCHAR_TO_UTF8(*value)));
+    CacheString(value, id);
+    return id;
+}
+
 FString sfPropertyUtil::ToString(sfProperty::SPtr propertyPtr)
 {
     if (SceneFusion::Service->Session() == nullptr)
@@ -55,9 +123,62 @@ FString sfPropertyUtil::ToString(sfProperty::SPtr propertyPtr)
         std::string str = valuePtr->GetValue();
         return FString(UTF8_TO_TCHAR(str.c_str()));
     }
-    uint32_t id = valuePtr->GetValue();
+    return GetStringFromTable(valuePtr->GetValue());
+}
+
+FString sfPropertyUtil::GetStringFromTable(uint32_t id)
+{
+    FString* strPtr = m_idStrings.Find(id);
+    if (strPtr != nullptr)
+    {
+        return *strPtr;
+    }
     sfName name = SceneFusion::Service->Session()->GetStringFromTable(id);
-    return FString(UTF8_TO_TCHAR(name->c_str()));
+    if (!name.IsValid())
+    {
+        return "";
+    }
+    FString str = UTF8_TO_TCHAR(name->c_str());
+    CacheString(str, id);
+    return str;
+}
+
+bool sfPropertyUtil::TryGetStringFromTable(uint32_t id, FString& str)
+{
+    FString* strPtr = m_idStrings.Find(id);
+    if (strPtr != nullptr)
+    {
+        str = *strPtr;
+        return true;
+    }
+    sfName name = SceneFusion::Service->Session()->GetStringFromTable(id);
+    if (!name.IsValid())
+    {
+        return false;
+    }
+    str = UTF8_TO_TCHAR(name->c_str());
+    return true;
+}
+
+void sfPropertyUtil::CacheString(const FString& value, uint32_t id)
+{
+    // Each string is stored twice
+    int bytes = (value.Len() + 1) * sizeof(TCHAR) * 2;
+    if (m_stringCacheBytes + bytes > MAX_STRING_CACHE_BYTES)
+    {
+        ClearStringCache();
+    }
+    m_stringIds.Add(value, id);
+    m_idStrings.Add(id, value);
+    m_stringCacheBytes += bytes;
+}
+
+void sfPropertyUtil::ClearStringCache()
+{
+    m_stringIds.Empty();
+    m_nameIds.Empty();
+    m_idStrings.Empty();
+    m_stringCacheBytes = 0;
 }
 
 sfUPropertyInstance sfPropertyUtil::FindUProperty(UObject* uobjPtr, sfProperty::SPtr propPtr)
@@ -66,192 +187,269 @@ sfUPropertyInstance sfPropertyUtil::FindUProperty(UObject* uobjPtr, sfProperty::
     {
         return sfUPropertyInstance();
     }
-    // Push property and its ancestors into a stack, so we can then iterate them from the top down
-    // We don't need to push the root dictionary into the stack
-    std::stack<sfProperty::SPtr> stack;
+    // Collect the property and its ancestors so we can then iterate them from the top down.
+    // We don't need to collect the root dictionary.
+    TArray<sfProperty::SPtr, TInlineAllocator<8>> path;
     while (propPtr->GetDepth() > 0)
     {
-        stack.push(propPtr);
+        path.Add(propPtr);
         propPtr = propPtr->GetParentProperty();
     }
-    UProperty* upropPtr = nullptr;
-    void* ptr = nullptr;// pointer to UProperty instance data
+    PathNode* nodePtr = nullptr;
+    uint8* ptr = nullptr;// pointer to UProperty instance data
     TSharedPtr<FScriptMapHelper> mapPtr = nullptr;
     TSharedPtr<FScriptSetHelper> setPtr = nullptr;
-    // Traverse properties from the top down, finding the UProperty at each level until we reach the one we want or
-    // don't find what we expect.
-    while (stack.size() > 0)
+    int i = path.Num() - 1;
+    if (i >= 0)
     {
-        propPtr = stack.top();
-        stack.pop();
-        if (upropPtr == nullptr)
+        // Get the first property from the object
+        propPtr = path[i];
+        nodePtr = GetRootPathNode(uobjPtr->GetClass(), propPtr->Key());
+        if (nodePtr != nullptr)
         {
-            // Get the first property from the object
-            upropPtr = uobjPtr->GetClass()->FindPropertyByName(FName(UTF8_TO_TCHAR(propPtr->Key()->c_str())));
-            if (upropPtr == nullptr)
+            ptr = (uint8*)uobjPtr + nodePtr->Offset;
+        }
+    }
+    // Traverse properties from the top down, following the cached path nodes until we reach the one we want or don't
+    // find what we expect. Struct fields and array elements are found with pointer arithmetic. Map and set helpers are
+    // only created when the path goes through a map or set.
+    for (i--; i >= 0 && nodePtr != nullptr; i--)
+    {
+        propPtr = path[i];
+        switch (nodePtr->Kind)
+        {
+            case PathNode::STRUCT:
             {
+                nodePtr = GetFieldPathNode(*nodePtr, propPtr->Key());
+                if (nodePtr != nullptr)
+                {
+                    ptr += nodePtr->Offset;
+                }
+                break;
+            }
+            case PathNode::ARRAY:
+            {
+                if (IsPackedSlice(static_cast<UArrayProperty*>(nodePtr->Property)->Inner, propPtr))
+                {
+                    // Packed slices hold ranges of elements and are applied by the array.
+                    i = 0;
+                    break;
+                }
+                FScriptArray* arrayPtr = (FScriptArray*)ptr;
+                int index = propPtr->Index();
+                if (index < 0 || index >= arrayPtr->Num())
+                {
+                    nodePtr = nullptr;
+                    break;
+                }
+                nodePtr = GetChildPathNode(nodePtr->Element, static_cast<UArrayProperty*>(nodePtr->Property)->Inner);
+                ptr = (uint8*)arrayPtr->GetData() + index * nodePtr->Property->ElementSize;
+                break;
+            }
+            case PathNode::MAP:
+            {
+                // Because maps are serialized as lists of key values, we expect at least one more property
+                if (i == 0)
+                {
+                    nodePtr = nullptr;
+                    break;
+                }
+                UMapProperty* mapPropPtr = static_cast<UMapProperty*>(nodePtr->Property);
+                mapPtr = MakeShareable(new FScriptMapHelper(mapPropPtr, ptr));
+                int sparseIndex = GetSparseIndex(*mapPtr, propPtr->Index());
+                if (sparseIndex < 0)
+                {
+                    nodePtr = nullptr;
+                    break;
+                }
+                // Check the index of the next property to determine if we want the map key or value.
+                i--;
+                propPtr = path[i];
+                if (propPtr->Index() == 0)
+                {
+                    nodePtr = GetChildPathNode(nodePtr->Element, mapPropPtr->KeyProp);
+                    ptr = mapPtr->GetKeyPtr(sparseIndex);
+                }
+                else if (propPtr->Index() == 1)
+                {
+                    nodePtr = GetChildPathNode(nodePtr->Value, mapPropPtr->ValueProp);
+                    ptr = mapPtr->GetValuePtr(sparseIndex);
+                    mapPtr = nullptr;
+                }
+                else
+                {
+                    nodePtr = nullptr;
+                }
+                break;
+            }
+            case PathNode::SET:
+            {
+                USetProperty* setPropPtr = static_cast<USetProperty*>(nodePtr->Property);
+                setPtr = MakeShareable(new FScriptSetHelper(setPropPtr, ptr));
+                int sparseIndex = GetSparseIndex(*setPtr, propPtr->Index());
+                if (sparseIndex < 0)
+                {
+                    nodePtr = nullptr;
+                    break;
+                }
+                nodePtr = GetChildPathNode(nodePtr->Element, setPropPtr->ElementProp);
+                ptr = setPtr->GetElementPtr(sparseIndex);
+                break;
+            }
+            default:
+            {
+                // We were expecting the UProperty to be one of the above container types but it was not. Abort.
+                nodePtr = nullptr;
                 break;
             }
-            ptr = upropPtr->ContainerPtrToValuePtr<void>(uobjPtr);
-            continue;
-        }
-        if (!GetStructField(propPtr->Key(), upropPtr, ptr) &&
-            !GetArrayElement(propPtr->Index(), upropPtr, ptr) &&
-            !GetMapElement(propPtr->Index(), upropPtr, ptr, mapPtr, stack) &&
-            !GetSetElement(propPtr->Index(), upropPtr, ptr, setPtr))
-        {
-            // We were expecting the UProperty to be one of the above container types but it was not. Abort.
-            upropPtr = nullptr;
-            break;
-        }
-        if (upropPtr == nullptr)
-        {
-            // We did not find the field or element we were looking for. Abort.
-            break;
         }
     }
-    if (upropPtr == nullptr)
+    if (nodePtr == nullptr)
     {
         KS::Log::Warning("Could not find property " + propPtr->GetPath() + " on " +
             std::string(TCHAR_TO_UTF8(*uobjPtr->GetClass()->GetName())), LOG_CHANNEL);
         return sfUPropertyInstance();
     }
-    return sfUPropertyInstance(upropPtr, ptr, mapPtr, setPtr);
+    return sfUPropertyInstance(nodePtr->Property, ptr, mapPtr, setPtr);
 }
 
-bool sfPropertyUtil::GetStructField(const sfName& name, UProperty*& upropPtr, void*& ptr)
+bool sfPropertyUtil::IsAssetReference(UClass* classPtr, sfProperty::SPtr propPtr)
 {
-    UStructProperty* structPropPtr = Cast<UStructProperty>(upropPtr);
-    if (structPropPtr == nullptr)
+    if (classPtr == nullptr || propPtr == nullptr)
     {
         return false;
     }
-    if (!name.IsValid())
+    TArray<sfProperty::SPtr, TInlineAllocator<8>> path;
+    while (propPtr->GetDepth() > 0)
     {
-        upropPtr = nullptr;
-        return true;
+        path.Add(propPtr);
+        propPtr = propPtr->GetParentProperty();
     }
-    upropPtr = structPropPtr->Struct->FindPropertyByName(FName(UTF8_TO_TCHAR(name->c_str())));
-    if (upropPtr != nullptr)
+    int i = path.Num() - 1;
+    PathNode* nodePtr = i < 0 ? nullptr : GetRootPathNode(classPtr, path[i]->Key());
+    // Follow the path through the cached path nodes. Element indexes don't matter since all elements of a container
+    // have the same uproperty.
+    for (i--; i >= 0 && nodePtr != nullptr; i--)
     {
-        ptr = upropPtr->ContainerPtrToValuePtr<void>(ptr);
+        switch (nodePtr->Kind)
+        {
+            case PathNode::STRUCT:
+            {
+                nodePtr = GetFieldPathNode(*nodePtr, path[i]->Key());
+                break;
+            }
+            case PathNode::ARRAY:
+            {
+                nodePtr = GetChildPathNode(nodePtr->Element, static_cast<UArrayProperty*>(nodePtr->Property)->Inner);
+                break;
+            }
+            case PathNode::SET:
+            {
+                nodePtr = GetChildPathNode(nodePtr->Element,
+                    static_cast<USetProperty*>(nodePtr->Property)->ElementProp);
+                break;
+            }
+            case PathNode::MAP:
+            {
+                // The next property is 0 for the key or 1 for the value
+                UMapProperty* mapPropPtr = static_cast<UMapProperty*>(nodePtr->Property);
+                i--;
+                if (i < 0)
+                {
+                    nodePtr = nullptr;
+                }
+                else if (path[i]->Index() == 0)
+                {
+                    nodePtr = GetChildPathNode(nodePtr->Element, mapPropPtr->KeyProp);
+                }
+                else if (path[i]->Index() == 1)
+                {
+                    nodePtr = GetChildPathNode(nodePtr->Value, mapPropPtr->ValueProp);
+                }
+                else
+                {
+                    nodePtr = nullptr;
+                }
+                break;
+            }
+            default:
+            {
+                nodePtr = nullptr;
+                break;
+            }
+        }
     }
-    return true;
+    return nodePtr != nullptr && nodePtr->Property->IsA<UObjectPropertyBase>();
 }
 
-bool sfPropertyUtil::GetArrayElement(int index, UProperty*& upropPtr, void*& ptr)
+sfPropertyUtil::PathNode* sfPropertyUtil::GetRootPathNode(UClass* classPtr, const sfName& name)
 {
-    UArrayProperty* arrayPropPtr = Cast<UArrayProperty>(upropPtr);
-    if (arrayPropPtr == nullptr)
+    if (!name.IsValid())
     {
-        return false;
+        return nullptr;
     }
-    FScriptArrayHelper array(arrayPropPtr, ptr);
-    if (index < 0 || index >= array.Num())
+    auto iter = m_pathCaches.find(classPtr);
+    if (iter == m_pathCaches.end() || iter->second.Class.Get() != classPtr)
     {
-        upropPtr = nullptr;
+        PathCache& cache = m_pathCaches[classPtr];
+        cache.Class = classPtr;
+        cache.Roots.clear();
+        iter = m_pathCaches.find(classPtr);
     }
-    else
+    std::unique_ptr<PathNode>& nodePtr = iter->second.Roots[name];
+    if (nodePtr == nullptr)
     {
-        upropPtr = arrayPropPtr->Inner;
-        ptr = array.GetRawPtr(index);
+        return GetChildPathNode(nodePtr, classPtr->FindPropertyByName(FName(UTF8_TO_TCHAR(name->c_str()))));
     }
-    return true;
+    return nodePtr->Property == nullptr ? nullptr : nodePtr.get();
 }
 
-bool sfPropertyUtil::GetMapElement(
-    int index,
-    UProperty*& upropPtr,
-    void*& ptr,
-    TSharedPtr<FScriptMapHelper>& outMapPtr,
-    std::stack<sfProperty::SPtr>& propertyStack)
+sfPropertyUtil::PathNode* sfPropertyUtil::GetFieldPathNode(PathNode& node, const sfName& name)
 {
-    UMapProperty* mapPropPtr = Cast<UMapProperty>(upropPtr);
-    if (mapPropPtr == nullptr)
-    {
-        return false;
-    }
-    // Because maps are serialized as lists of key values, we expect at least one more property in the stack
-    if (propertyStack.size() <= 0)
-    {
-        upropPtr = nullptr;
-        return true;
-    }
-    outMapPtr = MakeShareable(new FScriptMapHelper(mapPropPtr, ptr));
-    if (index < 0 || index >= outMapPtr->Num())
-    {
-        upropPtr = nullptr;
-        return true;
-    }
-    int sparseIndex = -1;
-    while (index >= 0)
-    {
-        sparseIndex++;
-        if (sparseIndex >= outMapPtr->GetMaxIndex())
-        {
-            upropPtr = nullptr;
-            return true;
-        }
-        if (outMapPtr->IsValidIndex(sparseIndex))
-        {
-            index--;
-        }
-    }
-    // Get the next property in the stack, and check its index to determine if we want the map key or value.
-    sfProperty::SPtr propPtr = propertyStack.top();
-    propertyStack.pop();
-    if (propPtr->Index() == 0)
-    {
-        upropPtr = mapPropPtr->KeyProp;
-        ptr = outMapPtr->GetKeyPtr(sparseIndex);
-    }
-    else if (propPtr->Index() == 1)
+    if (!name.IsValid())
     {
-        upropPtr = mapPropPtr->ValueProp;
-        ptr = outMapPtr->GetValuePtr(sparseIndex);
-        outMapPtr = nullptr;
+        return nullptr;
     }
-    else
+    std::unique_ptr<PathNode>& nodePtr = node.Fields[name];
+    if (nodePtr == nullptr)
     {
-        upropPtr = nullptr;
+        UStructProperty* structPropPtr = static_cast<UStructProperty*>(node.Property);
+        return GetChildPathNode(nodePtr,
+            structPropPtr->Struct->FindPropertyByName(FName(UTF8_TO_TCHAR(name->c_str()))));
     }
-    return true;
+    return nodePtr->Property == nullptr ? nullptr : nodePtr.get();
 }
 
-bool sfPropertyUtil::GetSetElement(
-    int index,
-    UProperty*& upropPtr,
-    void*& ptr,
-    TSharedPtr<FScriptSetHelper>& outSetPtr)
+sfPropertyUtil::PathNode* sfPropertyUtil::GetChildPathNode(std::unique_ptr<PathNode>& childPtr, UProperty* upropPtr)
 {
-    USetProperty* setPropPtr = Cast<USetProperty>(upropPtr);
-    if (setPropPtr == nullptr)
-    {
-        return false;
-    }
-    outSetPtr = MakeShareable(new FScriptSetHelper(setPropPtr, ptr));
-    if (index < 0 || index >= outSetPtr->Num())
-    {
-        upropPtr = nullptr;
-        return true;
-    }
-    int sparseIndex = -1;
-    while (index >= 0)
+    if (childPtr == nullptr)
     {
-        sparseIndex++;
-        if (sparseIndex >= outSetPtr->GetMaxIndex())
+        childPtr = std::unique_ptr<PathNode>(new PathNode());
+        childPtr->Property = upropPtr;
+        childPtr->Offset = 0;
+        childPtr->Kind = PathNode::VALUE;
+        if (upropPtr != nullptr)
         {
-            upropPtr = nullptr;
-            return true;
-        }
-        if (outSetPtr->IsValidIndex(sparseIndex))
-        {
-            index--;
+            childPtr->Offset = upropPtr->GetOffset_ForInternal();
+            if (upropPtr->IsA<UStructProperty>())
+            {
+                childPtr->Kind = PathNode::STRUCT;
+            }
+            else if (upropPtr->IsA<UArrayProperty>())
+            {
+                childPtr->Kind = PathNode::ARRAY;
+            }
+            else if (upropPtr->IsA<UMapProperty>())
+            {
+                childPtr->Kind = PathNode::MAP;
+            }
+            else if (upropPtr->IsA<USetProperty>())
+            {
+                childPtr->Kind = PathNode::SET;
+            }
         }
     }
-    upropPtr = setPropPtr->ElementProp;
-    ptr = outSetPtr->GetElementPtr(sparseIndex);
-    return true;
+    return childPtr->Property == nullptr ? nullptr : childPtr.get();
 }
 
 sfProperty::SPtr sfPropertyUtil::GetValue(UObject* uobjPtr, UProperty* upropPtr)
@@ -260,13 +458,17 @@ sfProperty::SPtr sfPropertyUtil::GetValue(UObject* uobjPtr, UProperty* upropPtr)
     {
         return nullptr;
     }
-    if (m_typeHandlers.size() == 0)
+    return GetValue(sfUPropertyInstance(upropPtr, upropPtr->ContainerPtrToValuePtr<void>(uobjPtr)));
+}
+
+sfProperty::SPtr sfPropertyUtil::GetValue(const sfUPropertyInstance& upropInstance)
+{
+    if (!upropInstance.IsValid())
     {
-        Initialize();
+        return nullptr;
     }
-    auto iter = m_typeHandlers.find(upropPtr->GetClass()->GetFName().GetComparisonIndex());
-    return iter == m_typeHandlers.end() ? nullptr : iter->second.Get(sfUPropertyInstance(upropPtr,
-        upropPtr->ContainerPtrToValuePtr<void>(uobjPtr)));
+    const TypeHandler* handlerPtr = GetTypeHandler(upropInstance.Property());
+    return handlerPtr == nullptr ? nullptr : handlerPtr->Get(upropInstance);
 }
 
 bool sfPropertyUtil::SetValue(UObject* uobjPtr, const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
@@ -275,12 +477,8 @@ bool sfPropertyUtil::SetValue(UObject* uobjPtr, const sfUPropertyInstance& uprop
     {
         return false;
     }
-    if (m_typeHandlers.size() == 0)
-    {
-        Initialize();
-    }
-    auto iter = m_typeHandlers.find(upropInstance.Property()->GetClass()->GetFName().GetComparisonIndex());
-    if (iter != m_typeHandlers.end() && iter->second.Set(upropInstance, propPtr))
+    const TypeHandler* handlerPtr = GetTypeHandler(upropInstance.Property());
+    if (handlerPtr != nullptr && handlerPtr->Set(upropInstance, propPtr))
     {
         MarkHashStale(upropInstance);
         MarkPropertyChanged(uobjPtr, upropInstance.Property(), propPtr);
@@ -295,13 +493,10 @@ bool sfPropertyUtil::IsDefaultValue(UObject* uobjPtr, UProperty* upropPtr)
     {
         return false;
     }
-    if (m_typeHandlers.size() == 0)
-    {
-        Initialize();
-    }
-    if (m_typeHandlers.find(upropPtr->GetClass()->GetFName().GetComparisonIndex()) != m_typeHandlers.end())
+    if (GetTypeHandler(upropPtr) != nullptr)
     {
-        return upropPtr->Identical_InContainer(uobjPtr, GetDefaultObject(uobjPtr));
+        return IsIdentical(upropPtr, upropPtr->HasAnyPropertyFlags(CPF_IsPlainOldData), uobjPtr,
+            GetDefaultObject(uobjPtr));
     }
     return false;
 }
@@ -312,30 +507,56 @@ void sfPropertyUtil::SetToDefaultValue(UObject* uobjPtr, UProperty* upropPtr)
     {
         return;
     }
-    if (m_typeHandlers.size() == 0)
-    {
-        Initialize();
-    }
-    if (m_typeHandlers.find(upropPtr->GetClass()->GetFName().GetComparisonIndex()) == m_typeHandlers.end())
+    if (GetTypeHandler(upropPtr) == nullptr)
     {
         return;
     }
     UObject* defaultObjPtr = GetDefaultObject(uobjPtr);
-    if (!upropPtr->Identical_InContainer(uobjPtr, defaultObjPtr))
+    if (!IsIdentical(upropPtr, upropPtr->HasAnyPropertyFlags(CPF_IsPlainOldData), uobjPtr, defaultObjPtr))
     {
         upropPtr->CopyCompleteValue_InContainer(uobjPtr, defaultObjPtr);
         MarkPropertyChanged(uobjPtr, upropPtr);
     }
 }
 
+void sfPropertyUtil::SetToRecordValue(UObject* uobjPtr, UProperty* upropPtr, sfDictionaryProperty::SPtr dictPtr)
+{
+    if (uobjPtr == nullptr || upropPtr == nullptr)
+    {
+        return;
+    }
+    sfProperty::SPtr propPtr = dictPtr == nullptr ? nullptr : GetRecordValue(uobjPtr, upropPtr, dictPtr);
+    const TypeHandler* handlerPtr = GetTypeHandler(upropPtr);
+    if (propPtr == nullptr || handlerPtr == nullptr)
+    {
+        SetToDefaultValue(uobjPtr, upropPtr);
+        return;
+    }
+    sfUPropertyInstance upropInstance(upropPtr, upropPtr->ContainerPtrToValuePtr<void>(uobjPtr));
+    if (handlerPtr->Set(upropInstance, propPtr))
+    {
+        MarkHashStale(upropInstance);
+        MarkPropertyChanged(uobjPtr, upropPtr);
+    }
+}
+
 UObject* sfPropertyUtil::GetDefaultObject(UObject* uobjPtr)
 {
-    // First try get the default sub object from the object's outer
+    // First try get the default sub object from the object's outer. Results are cached by outer class and name.
     UObject* defaultObjPtr = nullptr;
     if (uobjPtr->GetOuter() != nullptr)
     {
-        defaultObjPtr = uobjPtr->GetOuter()->GetClass()->GetDefaultObject()->GetDefaultSubobjectByName(
-            uobjPtr->GetFName());
+        TPair<UClass*, FName> key(uobjPtr->GetOuter()->GetClass(), uobjPtr->GetFName());
+        TWeakObjectPtr<UObject>* cachedPtr = m_defaultSubobjects.Find(key);
+        if (cachedPtr != nullptr && !cachedPtr->IsStale())
+        {
+            defaultObjPtr = cachedPtr->Get();
+        }
+        else
+        {
+            defaultObjPtr = key.Key->GetDefaultObject()->GetDefaultSubobjectByName(key.Value);
+            m_defaultSubobjects.Add(key, defaultObjPtr);
+        }
     }
     // If that fails, get the class default object
     if (defaultObjPtr == nullptr)
@@ -348,33 +569,205 @@ UObject* sfPropertyUtil::GetDefaultObject(UObject* uobjPtr)
 void sfPropertyUtil::CreateProperties(
     UObject* uobjPtr,
     sfDictionaryProperty::SPtr dictPtr,
-    const TSet<FString>* const blacklistPtr)
+    const TSet<FString>* const blacklistPtr,
+    bool useSchema)
 {
     if (uobjPtr == nullptr || dictPtr == nullptr)
     {
         return;
     }
-
-    for (TFieldIterator<UProperty> iter(uobjPtr->GetClass()); iter; ++iter)
+    m_contentHashes.Remove(uobjPtr);
+    SyncPlan& plan = GetSyncPlan(uobjPtr->GetClass());
+    const std::vector<bool>* blacklistedPtr = GetBlacklistFlags(plan, blacklistPtr);
+    // Class default objects never have default values
+    UObject* defaultObjPtr = uobjPtr == uobjPtr->GetClass()->GetDefaultObject() ? nullptr : GetDefaultObject(uobjPtr);
+    const Schema* schemaPtr = useSchema ? GetSchema(uobjPtr->GetClass(), plan) : nullptr;
+    const Template* templatePtr = nullptr;
+    if (schemaPtr != nullptr)
+    {
+        auto iter = m_templates.find(uobjPtr->GetClass());
+        templatePtr = iter == m_templates.end() ? nullptr : &iter->second;
+    }
+    // Recorded values are added in schema field order. A bit is set in the presence bitmap for each field that has a
+    // value.
+    std::vector<uint8_t> presence;
+    std::vector<sfProperty::SPtr> recordValues;
+    if (schemaPtr != nullptr)
+    {
+        presence.resize((schemaPtr->NumFields + 7) / 8);
+    }
+    int field = -1;
+    for (size_t i = 0; i < plan.Entries.size(); i++)
     {
-        if (IsSyncable(uobjPtr, *iter) && !IsDefaultValue(uobjPtr, *iter))
+        const SyncPlan::Entry& entry = plan.Entries[i];
+        bool recorded = schemaPtr != nullptr && plan.Recordable[i];
+        if (recorded)
+        {
+            field++;
+        }
+        if (blacklistedPtr != nullptr && (*blacklistedPtr)[i])
+        {
+            continue;
+        }
+        bool isDefault = defaultObjPtr != nullptr &&
+            IsIdentical(entry.Property, plan.PlainOldData[i], uobjPtr, defaultObjPtr);
+        if (recorded && !isDefault)
+        {
+            m_templateStats.Values++;
+        }
+        UObject* sourcePtr = recorded && templatePtr != nullptr ? templatePtr->Sources[i] : nullptr;
+        if (sourcePtr != nullptr)
         {
-            FString propertyName = iter->GetName();
-            if (blacklistPtr != nullptr && blacklistPtr->Contains(propertyName))
+            if (sourcePtr == uobjPtr || IsIdentical(entry.Property, plan.PlainOldData[i], uobjPtr, sourcePtr))
             {
                 continue;
             }
+            // Default values are recorded to override the template value.
+        }
+        else if (isDefault)
+        {
+            continue;
+        }
+        sfProperty::SPtr propPtr = entry.HandlerPtr->Get(sfUPropertyInstance(entry.Property,
+            entry.Property->ContainerPtrToValuePtr<void>(uobjPtr)));
+        if (propPtr == nullptr)
+        {
+            continue;
+        }
+        if (recorded)
+        {
+            presence[field / 8] |= 1 << (field % 8);
+            recordValues.push_back(propPtr);
+            m_templateStats.SentValues++;
+        }
+        else
+        {
+            dictPtr->Set(entry.Name, propPtr);
+        }
+    }
+    if (templatePtr != nullptr)
+    {
+        dictPtr->Set(sfProp::Template, sfReferenceProperty::Create(templatePtr->ObjectPtr->Id()));
+    }
+    if (recordValues.size() > 0)
+    {
+        sfListProperty::SPtr recordPtr = sfListProperty::Create();
+        recordPtr->Add(sfReferenceProperty::Create(schemaPtr->ObjectPtr->Id()));
+        recordPtr->Add(sfValueProperty::Create(ksMultiType(std::move(presence))));
+        recordPtr->AddRange(recordValues);
+        dictPtr->Set(sfProp::Record, recordPtr);
+    }
+    sfLoader::Get().AddStandInReferences(dictPtr);
+}
+
+void sfPropertyUtil::CreateTemplates(const TArray<UObject*>& uobjects)
+{
+    TMap<UClass*, TArray<UObject*>> objectsByClass;
+    for (UObject* uobjPtr : uobjects)
+    {
+        if (uobjPtr != nullptr && uobjPtr != uobjPtr->GetClass()->GetDefaultObject())
+        {
+            objectsByClass.FindOrAdd(uobjPtr->GetClass()).Add(uobjPtr);
+        }
+    }
+    sfSession::SPtr sessionPtr = SceneFusion::Service->Session();
+    for (const TPair<UClass*, TArray<UObject*>>& pair : objectsByClass)
+    {
+        const TArray<UObject*>& objects = pair.Value;
+        if (objects.Num() < MIN_TEMPLATE_OBJECTS || m_templates.find(pair.Key) != m_templates.end())
+        {
+            continue;
+        }
+        SyncPlan& plan = GetSyncPlan(pair.Key);
+        const Schema* schemaPtr = GetSchema(pair.Key, plan);
+        if (schemaPtr == nullptr)
+        {
+            return;
+        }
+        TArray<UObject*> defaultObjects;
+        for (UObject* uobjPtr : objects)
+        {
+            defaultObjects.Add(GetDefaultObject(uobjPtr));
+        }
 
-            sfProperty::SPtr propPtr = GetValue(uobjPtr, *iter);
+        Template newTemplate;
+        newTemplate.Sources.assign(plan.Entries.size(), nullptr);
+        std::vector<uint8_t> presence((schemaPtr->NumFields + 7) / 8);
+        std::vector<sfProperty::SPtr> values;
+        int field = -1;
+        for (size_t i = 0; i < plan.Entries.size(); i++)
+        {
+            if (!plan.Recordable[i])
+            {
+                continue;
+            }
+            field++;
+            // Find the most common non-default value by content hash. A value must be shared by at least two objects
+            // to be worth sending in the template. Hash collisions only affect which value is chosen, since objects
+            // are compared to the source object when creating their records.
+            const SyncPlan::Entry& entry = plan.Entries[i];
+            TMap<uint64_t, TPair<UObject*, int>> counts;
+            UObject* sourcePtr = nullptr;
+            int maxCount = 1;
+            for (int j = 0; j < objects.Num(); j++)
+            {
+                if (IsIdentical(entry.Property, plan.PlainOldData[i], objects[j], defaultObjects[j]))
+                {
+                    continue;
+                }
+                uint64_t hash = GetContentHash(objects[j], entry.Property);
+                if (hash == 0)
+                {
+                    continue;
+                }
+                TPair<UObject*, int>* countPtr = counts.Find(hash);
+                if (countPtr == nullptr)
+                {
+                    counts.Add(hash, TPair<UObject*, int>(objects[j], 1));
+                }
+                else if (++countPtr->Value > maxCount)
+                {
+                    maxCount = countPtr->Value;
+                    sourcePtr = countPtr->Key;
+                }
+            }
+            if (sourcePtr == nullptr)
+            {
+                continue;
+            }
+            sfProperty::SPtr propPtr = entry.HandlerPtr->Get(sfUPropertyInstance(entry.Property,
+                entry.Property->ContainerPtrToValuePtr<void>(sourcePtr)));
             if (propPtr != nullptr)
             {
-                std::string name = std::string(TCHAR_TO_UTF8(*propertyName));
-                dictPtr->Set(name, propPtr);
+                newTemplate.Sources[i] = sourcePtr;
+                presence[field / 8] |= 1 << (field % 8);
+                values.push_back(propPtr);
             }
         }
+        if (values.size() == 0)
+        {
+            continue;
+        }
+        sfListProperty::SPtr recordPtr = sfListProperty::Create();
+        recordPtr->Add(sfReferenceProperty::Create(schemaPtr->ObjectPtr->Id()));
+        recordPtr->Add(sfValueProperty::Create(ksMultiType(std::move(presence))));
+        recordPtr->AddRange(values);
+        sfDictionaryProperty::SPtr dictPtr = sfDictionaryProperty::Create();
+        dictPtr->Set(sfProp::Record, recordPtr);
+        newTemplate.ObjectPtr = sfObject::Create(sfType::PropertyTemplate, dictPtr);
+        sessionPtr->Create(newTemplate.ObjectPtr);
+        m_templateObjects.push_back(newTemplate.ObjectPtr);
+        m_templateStats.Templates++;
+        m_templateStats.SentValues += (int)values.size();
+        m_templates[pair.Key] = std::move(newTemplate);
     }
 }
 
+void sfPropertyUtil::ClearTemplates()
+{
+    m_templates.clear();
+}
+
 void sfPropertyUtil::ApplyProperties(
     UObject* uobjPtr,
     sfDictionaryProperty::SPtr dictPtr,
@@ -384,27 +777,42 @@ void sfPropertyUtil::ApplyProperties(
     {
         return;
     }
-    for (TFieldIterator<UProperty> iter(uobjPtr->GetClass()); iter; ++iter)
+    m_contentHashes.Remove(uobjPtr);
+    SyncPlan& plan = GetSyncPlan(uobjPtr->GetClass());
+    const std::vector<bool>* blacklistedPtr = GetBlacklistFlags(plan, blacklistPtr);
+    UObject* defaultObjPtr = nullptr;
+    // Named fields override recorded values
+    std::vector<sfProperty::SPtr> recordValues;
+    bool hasRecord = GetRecordValues(uobjPtr, plan, dictPtr, recordValues);
+    for (size_t i = 0; i < plan.Entries.size(); i++)
     {
-        if (IsSyncable(uobjPtr, *iter))
+        if (blacklistedPtr != nullptr && (*blacklistedPtr)[i])
         {
-            FString propertyName = iter->GetName();
-            if (blacklistPtr != nullptr && blacklistPtr->Contains(propertyName))
-            {
-                continue;
-            }
-
-            std::string name = std::string(TCHAR_TO_UTF8(*propertyName));
-            sfProperty::SPtr propPtr;
-            if (!dictPtr->TryGet(name, propPtr))
+            continue;
+        }
+        const SyncPlan::Entry& entry = plan.Entries[i];
+        sfProperty::SPtr propPtr;
+        if (!dictPtr->TryGet(entry.Name, propPtr) && hasRecord)
+        {
+            propPtr = recordValues[i];
+        }
+        if (propPtr == nullptr)
+        {
+            if (defaultObjPtr == nullptr)
             {
-                SetToDefaultValue(uobjPtr, *iter);
+                defaultObjPtr = GetDefaultObject(uobjPtr);
             }
-            else
+            if (!IsIdentical(entry.Property, plan.PlainOldData[i], uobjPtr, defaultObjPtr))
             {
-                SetValue(uobjPtr, sfUPropertyInstance(*iter, iter->ContainerPtrToValuePtr<void>(uobjPtr)), propPtr);
+                entry.Property->CopyCompleteValue_InContainer(uobjPtr, defaultObjPtr);
+                MarkPropertyChanged(uobjPtr, entry.Property);
             }
         }
+        else if (entry.HandlerPtr->Set(sfUPropertyInstance(entry.Property,
+            entry.Property->ContainerPtrToValuePtr<void>(uobjPtr)), propPtr))
+        {
+            MarkPropertyChanged(uobjPtr, entry.Property);
+        }
     }
 }
 
@@ -415,40 +823,412 @@ void sfPropertyUtil::SendPropertyChanges(
 {
     if (uobjPtr == nullptr || dictPtr == nullptr)
     {
-        return;
+        return;
+    }
+    SyncPlan& plan = GetSyncPlan(uobjPtr->GetClass());
+    const std::vector<bool>* blacklistedPtr = GetBlacklistFlags(plan, blacklistPtr);
+    // Class default objects never have default values
+    UObject* defaultObjPtr = uobjPtr == uobjPtr->GetClass()->GetDefaultObject() ? nullptr : GetDefaultObject(uobjPtr);
+    std::vector<sfProperty::SPtr> recordValues;
+    bool hasRecord = false;
+    bool recordValuesFound = false;
+    for (size_t i = 0; i < plan.Entries.size(); i++)
+    {
+        if (blacklistedPtr != nullptr && (*blacklistedPtr)[i])
+        {
+            continue;
+        }
+        const SyncPlan::Entry& entry = plan.Entries[i];
+        uint64_t hash = GetContentHash(uobjPtr, entry.Property);
+        if (IsContentUnchanged(uobjPtr, dictPtr, entry.Property, hash))
+        {
+            continue;
+        }
+        // Records are only read when a property changed, which is rare when sending changes for a whole object
+        if (!recordValuesFound)
+        {
+            hasRecord = GetRecordValues(uobjPtr, plan, dictPtr, recordValues);
+            recordValuesFound = true;
+        }
+        sfProperty::SPtr recordValuePtr = hasRecord ? recordValues[i] : nullptr;
+        sfProperty::SPtr oldPropPtr = nullptr;
+        bool hasField = dictPtr->TryGet(entry.Name, oldPropPtr);
+        // A recorded value is overridden by a named field, so a default value is sent as a named field if the record
+        // has a value.
+        if (defaultObjPtr != nullptr && recordValuePtr == nullptr &&
+            IsIdentical(entry.Property, plan.PlainOldData[i], uobjPtr, defaultObjPtr))
+        {
+            dictPtr->Remove(entry.Name);
+            SetContentHash(uobjPtr, dictPtr, entry.Property, hash);
+            continue;
+        }
+        sfProperty::SPtr propPtr = entry.HandlerPtr->Get(sfUPropertyInstance(entry.Property,
+            entry.Property->ContainerPtrToValuePtr<void>(uobjPtr)));
+        if (propPtr == nullptr)
+        {
+            continue;
+        }
+        if ((!hasField && (recordValuePtr == nullptr || !recordValuePtr->Equals(propPtr))) ||
+            (hasField && !Copy(oldPropPtr, propPtr)))
+        {
+            dictPtr->Set(entry.Name, propPtr);
+            oldPropPtr = propPtr;
+        }
+        sfLoader::Get().AddStandInReferences(oldPropPtr);
+        SetContentHash(uobjPtr, dictPtr, entry.Property, hash);
+    }
+}
+
+sfPropertyUtil::SyncPlan& sfPropertyUtil::GetSyncPlan(UClass* classPtr)
+{
+    auto iter = m_syncPlans.find(classPtr);
+    if (iter != m_syncPlans.end() && iter->second.Class.Get() == classPtr)
+    {
+        return iter->second;
+    }
+    SyncPlan& plan = m_syncPlans[classPtr];
+    plan.Class = classPtr;
+    plan.Entries.clear();
+    plan.PlainOldData.clear();
+    plan.Recordable.clear();
+    plan.BlacklistResults.clear();
+    for (TFieldIterator<UProperty> propIter(classPtr); propIter; ++propIter)
+    {
+        if (!IsSyncableForClass(classPtr, *propIter))
+        {
+            continue;
+        }
+        const TypeHandler* handlerPtr = GetTypeHandler(*propIter);
+        if (handlerPtr == nullptr)
+        {
+            // Unsupported property types are never synced
+            continue;
+        }
+        SyncPlan::Entry entry;
+        entry.Property = *propIter;
+        entry.NameString = propIter->GetName();
+        entry.Name = sfName(std::string(TCHAR_TO_UTF8(*entry.NameString)));
+        entry.HandlerPtr = handlerPtr;
+        plan.Entries.push_back(entry);
+        plan.PlainOldData.push_back(propIter->HasAnyPropertyFlags(CPF_IsPlainOldData));
+        plan.Recordable.push_back(IsRecordable(*propIter));
+    }
+    return plan;
+}
+
+const std::vector<bool>* sfPropertyUtil::GetBlacklistFlags(SyncPlan& plan, const TSet<FString>* const blacklistPtr)
+{
+    if (blacklistPtr == nullptr)
+    {
+        return nullptr;
+    }
+    auto iter = plan.BlacklistResults.find(blacklistPtr);
+    if (iter != plan.BlacklistResults.end())
+    {
+        return &iter->second;
+    }
+    std::vector<bool>& flags = plan.BlacklistResults[blacklistPtr];
+    flags.reserve(plan.Entries.size());
+    for (const SyncPlan::Entry& entry : plan.Entries)
+    {
+        flags.push_back(blacklistPtr->Contains(entry.NameString));
+    }
+    return &flags;
+}
+
+bool sfPropertyUtil::IsRecordable(UProperty* upropPtr)
+{
+    if (upropPtr->IsA<UObjectPropertyBase>())
+    {
+        return false;
+    }
+    UStructProperty* structPropPtr = Cast<UStructProperty>(upropPtr);
+    if (structPropPtr != nullptr)
+    {
+        for (TFieldIterator<UProperty> iter(structPropPtr->Struct); iter; ++iter)
+        {
+            if (!IsRecordable(*iter))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    UArrayProperty* arrayPropPtr = Cast<UArrayProperty>(upropPtr);
+    if (arrayPropPtr != nullptr)
+    {
+        return IsRecordable(arrayPropPtr->Inner);
+    }
+    UMapProperty* mapPropPtr = Cast<UMapProperty>(upropPtr);
+    if (mapPropPtr != nullptr)
+    {
+        return IsRecordable(mapPropPtr->KeyProp) && IsRecordable(mapPropPtr->ValueProp);
+    }
+    USetProperty* setPropPtr = Cast<USetProperty>(upropPtr);
+    if (setPropPtr != nullptr)
+    {
+        return IsRecordable(setPropPtr->ElementProp);
+    }
+    return true;
+}
+
+const sfPropertyUtil::Schema* sfPropertyUtil::GetSchema(UClass* classPtr, SyncPlan& plan)
+{
+    auto iter = m_schemas.find(classPtr);
+    if (iter != m_schemas.end() && iter->second.Class.Get() == classPtr)
+    {
+        return &iter->second;
+    }
+    sfSession::SPtr sessionPtr = SceneFusion::Service->Session();
+    if (sessionPtr == nullptr)
+    {
+        return nullptr;
+    }
+    FString path = classPtr->GetPathName();
+    int& version = m_schemaVersions.FindOrAdd(path);
+    version++;
+    sfDictionaryProperty::SPtr dictPtr = sfDictionaryProperty::Create();
+    sfListProperty::SPtr fieldsPtr = sfListProperty::Create();
+    sfListProperty::SPtr typesPtr = sfListProperty::Create();
+    for (size_t i = 0; i < plan.Entries.size(); i++)
+    {
+        if (plan.Recordable[i])
+        {
+            fieldsPtr->Add(FromName(plan.Entries[i].Property->GetFName()));
+            typesPtr->Add(FromName(plan.Entries[i].Property->GetClass()->GetFName()));
+        }
+    }
+    dictPtr->Set(sfProp::Class, FromString(path));
+    dictPtr->Set(sfProp::Version, sfValueProperty::Create(version));
+    dictPtr->Set(sfProp::Fields, fieldsPtr);
+    dictPtr->Set(sfProp::Types, typesPtr);
+
+    Schema& schema = m_schemas[classPtr];
+    schema.Class = classPtr;
+    schema.ObjectPtr = sfObject::Create(sfType::PropertySchema, dictPtr);
+    schema.NumFields = fieldsPtr->Size();
+    sessionPtr->Create(schema.ObjectPtr);
+    return &schema;
+}
+
+const sfPropertyUtil::ResolvedSchema* sfPropertyUtil::ResolveSchema(
+    UClass* classPtr,
+    SyncPlan& plan,
+    sfListProperty::SPtr recordPtr)
+{
+    if (recordPtr->Size() < 2 || recordPtr->Get(0)->Type() != sfProperty::REFERENCE ||
+        recordPtr->Get(1)->Type() != sfProperty::VALUE)
+    {
+        return nullptr;
+    }
+    uint32_t schemaId = recordPtr->Get(0)->AsReference()->GetObjectId();
+    auto iter = m_resolvedSchemas.find(schemaId);
+    if (iter != m_resolvedSchemas.end() && iter->second.Class.Get() == classPtr)
+    {
+        return &iter->second;
+    }
+    sfSession::SPtr sessionPtr = SceneFusion::Service->Session();
+    sfObject::SPtr schemaObjPtr = sessionPtr == nullptr ? nullptr : sessionPtr->GetObject(schemaId);
+    sfProperty::SPtr fieldsPtr;
+    sfProperty::SPtr typesPtr;
+    if (schemaObjPtr == nullptr || schemaObjPtr->Type() != sfType::PropertySchema ||
+        !schemaObjPtr->Property()->AsDict()->TryGet(sfProp::Fields, fieldsPtr) ||
+        !schemaObjPtr->Property()->AsDict()->TryGet(sfProp::Types, typesPtr) ||
+        fieldsPtr->Type() != sfProperty::LIST || typesPtr->Type() != sfProperty::LIST ||
+        fieldsPtr->AsList()->Size() != typesPtr->AsList()->Size())
+    {
+        bool alreadyWarned = false;
+        m_missingSchemas.Add(schemaId, &alreadyWarned);
+        if (!alreadyWarned)
+        {
+            KS::Log::Warning("Could not find property schema " + std::to_string(schemaId) + " for " +
+                std::string(TCHAR_TO_UTF8(*classPtr->GetName())) + ".", LOG_CHANNEL);
+        }
+        return nullptr;
+    }
+
+    TMap<FString, int> entryIndexes;
+    for (size_t i = 0; i < plan.Entries.size(); i++)
+    {
+        entryIndexes.Add(plan.Entries[i].NameString, (int)i);
+    }
+    ResolvedSchema& schema = m_resolvedSchemas[schemaId];
+    schema.Class = classPtr;
+    schema.Entries.clear();
+    schema.Fields.assign(plan.Entries.size(), -1);
+    for (int i = 0; i < fieldsPtr->AsList()->Size(); i++)
+    {
+        // Fields that are missing or have a different type, such as after a hot reload, are ignored
+        int* indexPtr = entryIndexes.Find(ToString(fieldsPtr->AsList()->Get(i)));
+        if (indexPtr != nullptr && plan.Entries[*indexPtr].Property->GetClass()->GetName() ==
+            ToString(typesPtr->AsList()->Get(i)))
+        {
+            schema.Entries.push_back(*indexPtr);
+            schema.Fields[*indexPtr] = i;
+        }
+        else
+        {
+            schema.Entries.push_back(-1);
+        }
+    }
+    return &schema;
+}
+
+bool sfPropertyUtil::ReadRecord(
+    UClass* classPtr,
+    SyncPlan& plan,
+    sfDictionaryProperty::SPtr dictPtr,
+    std::vector<sfProperty::SPtr>& values)
+{
+    sfProperty::SPtr propPtr;
+    if (!dictPtr->TryGet(sfProp::Record, propPtr) || propPtr->Type() != sfProperty::LIST)
+    {
+        return false;
+    }
+    sfListProperty::SPtr recordPtr = propPtr->AsList();
+    const ResolvedSchema* schemaPtr = ResolveSchema(classPtr, plan, recordPtr);
+    if (schemaPtr == nullptr)
+    {
+        return false;
+    }
+    const std::vector<uint8_t>& presence = recordPtr->Get(1)->AsValue()->GetValue().GetData();
+    int valueIndex = 2;
+    for (size_t field = 0; field < schemaPtr->Entries.size() && field / 8 < presence.size(); field++)
+    {
+        if ((presence[field / 8] & (1 << (field % 8))) == 0)
+        {
+            continue;
+        }
+        if (valueIndex >= recordPtr->Size())
+        {
+            break;
+        }
+        int entry = schemaPtr->Entries[field];
+        if (entry >= 0)
+        {
+            values[entry] = recordPtr->Get(valueIndex);
+        }
+        valueIndex++;
+    }
+    return true;
+}
+
+sfProperty::SPtr sfPropertyUtil::ReadRecordValue(
+    UClass* classPtr,
+    SyncPlan& plan,
+    sfDictionaryProperty::SPtr dictPtr,
+    int entry)
+{
+    sfProperty::SPtr propPtr;
+    if (!dictPtr->TryGet(sfProp::Record, propPtr) || propPtr->Type() != sfProperty::LIST)
+    {
+        return nullptr;
+    }
+    sfListProperty::SPtr recordPtr = propPtr->AsList();
+    const ResolvedSchema* schemaPtr = ResolveSchema(classPtr, plan, recordPtr);
+    if (schemaPtr == nullptr || entry >= (int)schemaPtr->Fields.size() || schemaPtr->Fields[entry] < 0)
+    {
+        return nullptr;
+    }
+    int field = schemaPtr->Fields[entry];
+    const std::vector<uint8_t>& presence = recordPtr->Get(1)->AsValue()->GetValue().GetData();
+    if ((size_t)field / 8 >= presence.size() || (presence[field / 8] & (1 << (field % 8))) == 0)
+    {
+        return nullptr;
+    }
+    // Values are in field order after the schema and presence bitmap, so we count the present fields before this one.
+    int valueIndex = 2;
+    for (int i = 0; i < field; i++)
+    {
+        if ((presence[i / 8] & (1 << (i % 8))) != 0)
+        {
+            valueIndex++;
+        }
+    }
+    return valueIndex < recordPtr->Size() ? recordPtr->Get(valueIndex) : nullptr;
+}
+
+sfDictionaryProperty::SPtr sfPropertyUtil::FindTemplate(UObject* uobjPtr, sfDictionaryProperty::SPtr dictPtr)
+{
+    sfProperty::SPtr propPtr;
+    if (!dictPtr->TryGet(sfProp::Template, propPtr) || propPtr->Type() != sfProperty::REFERENCE)
+    {
+        return nullptr;
+    }
+    uint32_t templateId = propPtr->AsReference()->GetObjectId();
+    sfSession::SPtr sessionPtr = SceneFusion::Service->Session();
+    sfObject::SPtr templateObjPtr = sessionPtr == nullptr ? nullptr : sessionPtr->GetObject(templateId);
+    if (templateObjPtr == nullptr || templateObjPtr->Type() != sfType::PropertyTemplate)
+    {
+        KS::Log::Warning("Could not find property template " + std::to_string(templateId) + " for " +
+            std::string(TCHAR_TO_UTF8(*uobjPtr->GetName())) + ".", LOG_CHANNEL);
+        return nullptr;
+    }
+    return templateObjPtr->Property()->AsDict();
+}
+
+bool sfPropertyUtil::GetRecordValues(
+    UObject* uobjPtr,
+    SyncPlan& plan,
+    sfDictionaryProperty::SPtr dictPtr,
+    std::vector<sfProperty::SPtr>& values)
+{
+    values.assign(plan.Entries.size(), nullptr);
+    // Templates are expanded when they are used instead of when they are received, since most templates are only used
+    // while creating the objects that refer to them.
+    sfDictionaryProperty::SPtr templatePtr = FindTemplate(uobjPtr, dictPtr);
+    bool found = templatePtr != nullptr && ReadRecord(uobjPtr->GetClass(), plan, templatePtr, values);
+    // Values in the object's record override template values
+    return ReadRecord(uobjPtr->GetClass(), plan, dictPtr, values) || found;
+}
+
+sfProperty::SPtr sfPropertyUtil::GetRecordValue(
+    UObject* uobjPtr,
+    UProperty* upropPtr,
+    sfDictionaryProperty::SPtr dictPtr)
+{
+    if (!dictPtr->HasKey(sfProp::Record) && !dictPtr->HasKey(sfProp::Template))
+    {
+        return nullptr;
+    }
+    // Only the field for the property is read, so nothing is allocated and the other values are not expanded.
+    SyncPlan& plan = GetSyncPlan(uobjPtr->GetClass());
+    int entry = -1;
+    for (size_t i = 0; i < plan.Entries.size(); i++)
+    {
+        if (plan.Entries[i].Property == upropPtr)
+        {
+            entry = (int)i;
+            break;
+        }
+    }
+    if (entry < 0)
+    {
+        return nullptr;
     }
-    for (TFieldIterator<UProperty> iter(uobjPtr->GetClass()); iter; ++iter)
+    // Values in the object's record override template values
+    sfProperty::SPtr valuePtr = ReadRecordValue(uobjPtr->GetClass(), plan, dictPtr, entry);
+    if (valuePtr == nullptr)
     {
-        if (IsSyncable(uobjPtr, *iter))
+        sfDictionaryProperty::SPtr templatePtr = FindTemplate(uobjPtr, dictPtr);
+        if (templatePtr != nullptr)
         {
-            FString propertyName = iter->GetName();
-            if (blacklistPtr != nullptr && blacklistPtr->Contains(propertyName))
-            {
-                continue;
-            }
-
-            if (IsDefaultValue(uobjPtr, *iter))
-            {
-                std::string name = std::string(TCHAR_TO_UTF8(*propertyName));
-                dictPtr->Remove(name);
-            }
-            else
-            {
-                sfProperty::SPtr propPtr = GetValue(uobjPtr, *iter);
-                if (propPtr == nullptr)
-                {
-                    continue;
-                }
-
-                std::string name = std::string(TCHAR_TO_UTF8(*propertyName));
-                sfProperty::SPtr oldPropPtr = nullptr;
-                if (!dictPtr->TryGet(name, oldPropPtr) || !Copy(oldPropPtr, propPtr))
-                {
-                    dictPtr->Set(name, propPtr);
-                }
-            }
+            valuePtr = ReadRecordValue(uobjPtr->GetClass(), plan, templatePtr, entry);
         }
     }
+    return valuePtr;
+}
+
+void sfPropertyUtil::ClearSyncPlans()
+{
+    m_syncPlans.clear();
+    m_pathCaches.clear();
+    m_schemas.clear();
+    m_resolvedSchemas.clear();
+    m_missingSchemas.Empty();
+    m_templates.clear();
+    m_defaultSubobjects.Empty();
+    m_contentHashes.Empty();
 }
 
 void sfPropertyUtil::SetReferences(UObject* uobjPtr, const std::vector<sfReferenceProperty::SPtr>& references)
@@ -519,15 +1299,22 @@ bool sfPropertyUtil::Copy(sfProperty::SPtr destPtr, sfProperty::SPtr srcPtr)
     return true;
 }
 
+void sfPropertyUtil::ClearContentHashes(UObject* uobjPtr)
+{
+    m_contentHashes.Remove(uobjPtr);
+}
+
 void sfPropertyUtil::MarkHashStale(const sfUPropertyInstance& upropInstance)
 {
     if (upropInstance.ContainerMap().IsValid())
     {
         m_staleMaps.Add(upropInstance.ContainerMap()->Map, upropInstance.ContainerMap());
+        InvalidateSparseIndexes(upropInstance.ContainerMap()->Map);
     }
     if (upropInstance.ContainerSet().IsValid())
     {
         m_staleSets.Add(upropInstance.ContainerSet()->Set, upropInstance.ContainerSet());
+        InvalidateSparseIndexes(upropInstance.ContainerSet()->Set);
     }
 }
 
@@ -543,6 +1330,8 @@ void sfPropertyUtil::RehashProperties()
         pair.Value->Rehash();
     }
     m_staleSets.Empty();
+    // Containers may be changed locally before the next rehash
+    m_sparseIndexes.Empty();
 }
 
 void sfPropertyUtil::MarkPropertyChanged(UObject* uobjPtr, UProperty* upropPtr, sfProperty::SPtr propPtr)
@@ -569,6 +1358,12 @@ void sfPropertyUtil::MarkPropertyChanged(UObject* uobjPtr, UProperty* upropPtr,
     {
         return;
     }
+    // The value no longer matches the hash of the value we last synced
+    ContentHashes* hashesPtr = m_contentHashes.Find(uobjPtr);
+    if (hashesPtr != nullptr)
+    {
+        hashesPtr->Hashes.Remove(upropPtr);
+    }
     // Workaround for a bug where moving a level will move all the level actors twice.
     // This bug was happening because actor transform changes got applied first, and then when we move the level,
     // Unreal will move the level actors again with an offset. This bug will be fixed if make actor transform relative
@@ -581,16 +1376,16 @@ void sfPropertyUtil::MarkPropertyChanged(UObject* uobjPtr, UProperty* upropPtr,
         EnablePropertyChangeHandler();
         return;
     }
-    bool alreadyInSet = false;
-    m_serverChangedProperties.Emplace(TPair<UObject*, UProperty*>(uobjPtr, upropPtr), &alreadyInSet);
-    if (alreadyInSet)
+    TArray<UProperty*>& properties = m_serverChangedProperties.FindOrAdd(uobjPtr);
+    if (properties.Contains(upropPtr))
     {
         return;
     }
+    properties.Add(upropPtr);
     AActor* actorPtr = Cast<AActor>(uobjPtr->GetOuter());
     if (actorPtr != nullptr)
     {
-        m_serverChangedProperties.Emplace(TPair<UObject*, UProperty*>(actorPtr, nullptr));
+        m_serverChangedProperties.FindOrAdd(actorPtr).AddUnique(nullptr);
     }
 }
 
@@ -601,43 +1396,191 @@ void sfPropertyUtil::BroadcastChangeEvents()
         return;
     }
     DisablePropertyChangeHandler();
-    for (TPair<UObject*, UProperty*>& pair : m_serverChangedProperties)
+    for (TPair<UObject*, TArray<UProperty*>>& pair : m_serverChangedProperties)
     {
         // Check if the uobject is in the sfobjectmap to ensure it is a valid pointer
-        if (sfObjectMap::Contains(pair.Key))
+        if (!sfObjectMap::Contains(pair.Key))
         {
-            FPropertyChangedEvent propertyEvent(pair.Value);
-            AActor* actorPtr = Cast<AActor>(pair.Key);
-            bool oldActorSeamlessTraveled = false;
-            if (actorPtr != nullptr)
-            {
-                oldActorSeamlessTraveled = actorPtr->bActorSeamlessTraveled;
-
-                // Calling PostEditChangeProperty triggers blueprint actors to be reconstructed and will trigger an
-                // assertion because the cached transform is different from the real one.
-                // Setting bActorSeamlessTraveled to true will prevent this from happening.
-                actorPtr->bActorSeamlessTraveled = true;
-            }
+            continue;
+        }
+        AActor* actorPtr = Cast<AActor>(pair.Key);
+        if (actorPtr != nullptr)
+        {
+            BroadcastActorChangeEvents(actorPtr, pair.Value);
+            continue;
+        }
+        for (UProperty* upropPtr : pair.Value)
+        {
+            FPropertyChangedEvent propertyEvent(upropPtr);
             pair.Key->PostEditChangeProperty(propertyEvent);
-            if (actorPtr != nullptr)
-            {
-                actorPtr->bActorSeamlessTraveled = oldActorSeamlessTraveled;
-            }
+            m_changeEventStats.Events++;
         }
     }
     m_serverChangedProperties.Empty();
     EnablePropertyChangeHandler();
 }
 
+void sfPropertyUtil::BroadcastActorChangeEvents(AActor* actorPtr, TArray<UProperty*>& properties)
+{
+    int numChanges = properties.Num();
+    // The nullptr component change event is redundant if the actor has its own property events
+    if (numChanges > 1)
+    {
+        properties.Remove(nullptr);
+    }
+
+    // Calling PostEditChangeProperty triggers blueprint actors to be reconstructed and will trigger an
+    // assertion because the cached transform is different from the real one.
+    // Setting bActorSeamlessTraveled to true will prevent this from happening.
+    bool oldActorSeamlessTraveled = actorPtr->bActorSeamlessTraveled;
+    actorPtr->bActorSeamlessTraveled = true;
+    if (Cast<UBlueprint>(actorPtr->GetClass()->ClassGeneratedBy) == nullptr)
+    {
+        // Only blueprint actors have construction scripts to batch
+        for (UProperty* upropPtr : properties)
+        {
+            FPropertyChangedEvent propertyEvent(upropPtr);
+            actorPtr->PostEditChangeProperty(propertyEvent);
+            m_changeEventStats.Events++;
+        }
+        actorPtr->bActorSeamlessTraveled = oldActorSeamlessTraveled;
+        return;
+    }
+    // Interactive changes do not run the construction script when bRunConstructionScriptOnDrag is false, so we send
+    // every change but the last as interactive to reconstruct the actor once.
+    bool oldRunConstructionScriptOnDrag = actorPtr->bRunConstructionScriptOnDrag;
+    actorPtr->bRunConstructionScriptOnDrag = false;
+    for (int i = 0; i < properties.Num(); i++)
+    {
+        FPropertyChangedEvent propertyEvent(properties[i],
+            i < properties.Num() - 1 ? EPropertyChangeType::Interactive : EPropertyChangeType::Unspecified);
+        actorPtr->PostEditChangeProperty(propertyEvent);
+        m_changeEventStats.Events++;
+    }
+    actorPtr->bRunConstructionScriptOnDrag = oldRunConstructionScriptOnDrag;
+    actorPtr->bActorSeamlessTraveled = oldActorSeamlessTraveled;
+    m_changeEventStats.ConstructionScriptRunsAvoided += properties.Num() - 1;
+}
+
 void sfPropertyUtil::AddPropertyToForceSyncList(FName ownerClassName, FName propertyName)
 {
     // Register extra properties to sync
     m_forceSyncList.Add(TPair<FName, FName>(ownerClassName, propertyName));
+    ClearSyncPlans();
 }
 
 void sfPropertyUtil::IgnoreDisableEditOnInstanceFlagForClass(FName className)
 {
     m_syncDefaultOnlyList.Add(className);
+    ClearSyncPlans();
+}
+
+void sfPropertyUtil::SetSyncInterval(FName className, float seconds)
+{
+    m_classSyncIntervals.Add(className, seconds);
+}
+
+void sfPropertyUtil::SetSyncInterval(FName ownerClassName, FName propertyName, float seconds)
+{
+    m_propertySyncIntervals.Add(TPair<FName, FName>(ownerClassName, propertyName), seconds);
+}
+
+void sfPropertyUtil::RegisterBlittableStruct(FName structName)
+{
+    m_blittableStructs.Add(structName);
+}
+
+bool sfPropertyUtil::CanPack(UProperty* upropPtr)
+{
+    if (upropPtr->IsA<UNumericProperty>())
+    {
+        return true;
+    }
+    UStructProperty* structPropPtr = Cast<UStructProperty>(upropPtr);
+    return structPropPtr != nullptr && (structPropPtr->Struct->StructFlags & STRUCT_IsPlainOldData);
+}
+
+uint8_t sfPropertyUtil::GetPackedType(UProperty* upropPtr)
+{
+    if (upropPtr->IsA<UFloatProperty>())
+    {
+        return ksMultiType::FLOAT_ARRAY;
+    }
+    if (upropPtr->IsA<UIntProperty>())
+    {
+        return ksMultiType::INT_ARRAY;
+    }
+    if (upropPtr->IsA<UUInt32Property>())
+    {
+        return ksMultiType::UINT_ARRAY;
+    }
+    if (upropPtr->IsA<UInt64Property>())
+    {
+        return ksMultiType::LONG_ARRAY;
+    }
+    return CanPack(upropPtr) ? ksMultiType::BYTE_ARRAY : ksMultiType::UNDEFINED;
+}
+
+int sfPropertyUtil::GetPackedSliceCapacity(UProperty* upropPtr)
+{
+    return FMath::Max(1, PACKED_SLICE_BYTES / upropPtr->ElementSize);
+}
+
+int sfPropertyUtil::GetPackedSliceLength(uint8_t packedType, int elementSize, sfProperty::SPtr slicePtr)
+{
+    if (slicePtr == nullptr || slicePtr->Type() != sfProperty::VALUE)
+    {
+        return -1;
+    }
+    const ksMultiType& value = slicePtr->AsValue()->GetValue();
+    if (value.GetType() != packedType || value.GetData().size() % elementSize != 0)
+    {
+        return -1;
+    }
+    return (int)value.GetData().size() / elementSize;
+}
+
+bool sfPropertyUtil::IsPackedSlice(UProperty* elementPropPtr, sfProperty::SPtr propPtr)
+{
+    // Double and blittable struct elements are also byte arrays, so slices are only expected when packing is enabled.
+    if (!sfConfig::Get().PackedArrays || propPtr == nullptr || propPtr->Type() != sfProperty::VALUE)
+    {
+        return false;
+    }
+    uint8_t packedType = GetPackedType(elementPropPtr);
+    return packedType != ksMultiType::UNDEFINED && propPtr->AsValue()->GetValue().GetType() == packedType;
+}
+
+bool sfPropertyUtil::IsPackedList(UProperty* elementPropPtr, sfListProperty::SPtr listPtr)
+{
+    return listPtr->Size() > 0 && IsPackedSlice(elementPropPtr, listPtr->Get(0));
+}
+
+bool sfPropertyUtil::IsBlittable(UScriptStruct* structPtr)
+{
+    return sfConfig::Get().BlittableStructs && (structPtr->StructFlags & STRUCT_IsPlainOldData) &&
+        m_blittableStructs.Contains(structPtr->GetFName());
+}
+
+void sfPropertyUtil::CopyStructWithoutPadding(UStruct* structPtr, const void* srcPtr, uint8_t* destPtr)
+{
+    for (TFieldIterator<UProperty> iter(structPtr); iter; ++iter)
+    {
+        UProperty* fieldPtr = *iter;
+        UStructProperty* structPropPtr = Cast<UStructProperty>(fieldPtr);
+        for (int i = 0; i < fieldPtr->ArrayDim; i++)
+        {
+            int offset = fieldPtr->GetOffset_ForInternal() + i * fieldPtr->ElementSize;
+            if (structPropPtr != nullptr)
+            {
+                CopyStructWithoutPadding(structPropPtr->Struct, (const uint8_t*)srcPtr + offset, destPtr + offset);
+            }
+            else
+            {
+                std::memcpy(destPtr + offset, (const uint8_t*)srcPtr + offset, fieldPtr->ElementSize);
+            }
+        }
+    }
 }
 
 void sfPropertyUtil::EnablePropertyChangeHandler()
@@ -659,25 +1602,68 @@ bool sfPropertyUtil::ListeningForPropertyChanges()
 
 void sfPropertyUtil::SyncProperties()
 {
+    double now = FPlatformTime::Seconds();
+    // Queue held back properties whose throttle time ended so their last value is sent (trailing edge)
+    for (auto iter = m_deferredProperties.CreateIterator(); iter; ++iter)
+    {
+        double* throttleTimePtr = m_throttleTimes.Find(iter.Key());
+        if (throttleTimePtr != nullptr && *throttleTimePtr > now)
+        {
+            continue;
+        }
+        if (iter.Value().IsValid() && !m_localChangedProperties.Contains(iter.Key()))
+        {
+            m_localChangedProperties.Add(iter.Key(), false);
+        }
+        iter.RemoveCurrent();
+    }
+    for (auto iter = m_throttleTimes.CreateIterator(); iter; ++iter)
+    {
+        if (iter.Value() <= now)
+        {
+            iter.RemoveCurrent();
+        }
+    }
+
     for (auto& iter : m_localChangedProperties)
     {
         // uobjPtr may be an invalid pointer, in which case it will not have an sfObject. Do not try dereferencing
         // until we see if it has an sfObject.
-        UObject* uobjPtr = iter.Key;
+        UObject* uobjPtr = iter.Key.Key;
+        UProperty* upropPtr = iter.Key.Value;
         sfObject::SPtr objPtr = sfObjectMap::GetSFObject(uobjPtr);
         if (uobjPtr->IsPendingKill())
         {
             continue;
         }
 
+        if (!iter.Value)
+        {
+            // The change is final, so any held back change is superseded
+            m_deferredProperties.Remove(iter.Key);
+        }
+        else if (m_throttleTimes.Contains(iter.Key))
+        {
+            // The property was sent recently. Hold the change back until the throttle time ends.
+            m_deferredProperties.Add(iter.Key, uobjPtr);
+            m_throttleStats.Suppressed++;
+            continue;
+        }
+        float interval = GetSyncInterval(uobjPtr->GetClass(), upropPtr);
+        if (interval > 0.0f)
+        {
+            m_throttleTimes.Add(iter.Key, now + interval);
+        }
+        m_throttleStats.Sent++;
+
         PropertyChangeHandler handler = m_classNameToPropertyChangeHandler.FindRef(uobjPtr->GetClass()->GetFName());
         if (handler != nullptr)
         {
-            handler(uobjPtr, iter.Value);
+            handler(uobjPtr, upropPtr);
         }
         else if (objPtr != nullptr)
         {
-            SyncProperty(objPtr, uobjPtr, iter.Value);
+            SyncProperty(objPtr, uobjPtr, upropPtr);
         }
     }
     m_localChangedProperties.Empty();
@@ -723,15 +1709,26 @@ void sfPropertyUtil::SyncProperty(sfObject::SPtr objPtr, UObject* uobjPtr, UProp
         }
         else
         {
-            SetToDefaultValue(uobjPtr, upropPtr);
+            SetToRecordValue(uobjPtr, upropPtr, propertiesPtr);
         }
     }
-    else if (IsDefaultValue(uobjPtr, upropPtr))
-    {
-        propertiesPtr->Remove(name);
-    }
     else
     {
+        // Skip the property if it has not changed since we last synced it
+        uint64_t hash = GetContentHash(uobjPtr, upropPtr);
+        if (IsContentUnchanged(uobjPtr, propertiesPtr, upropPtr, hash))
+        {
+            return;
+        }
+        // A recorded value is overridden by a named field, so a default value is sent as a named field if the record
+        // has a value.
+        sfProperty::SPtr recordValuePtr = GetRecordValue(uobjPtr, upropPtr, propertiesPtr);
+        if (recordValuePtr == nullptr && IsDefaultValue(uobjPtr, upropPtr))
+        {
+            propertiesPtr->Remove(name);
+            SetContentHash(uobjPtr, propertiesPtr, upropPtr, hash);
+            return;
+        }
         sfProperty::SPtr propPtr = GetValue(uobjPtr, upropPtr);
         sfProperty::SPtr oldPropPtr;
         if (propPtr == nullptr)
@@ -739,11 +1736,17 @@ void sfPropertyUtil::SyncProperty(sfObject::SPtr objPtr, UObject* uobjPtr, UProp
             FString str = upropPtr->GetClass()->GetName() + " is not supported by Scene Fusion. Changes to " +
                 upropPtr->GetName() + " will not sync.";
             KS::Log::Warning(TCHAR_TO_UTF8(*str));
+            return;
         }
-        else if (!propertiesPtr->TryGet(name, oldPropPtr) || !Copy(oldPropPtr, propPtr))
+        bool hasField = propertiesPtr->TryGet(name, oldPropPtr);
+        if ((!hasField && (recordValuePtr == nullptr || !recordValuePtr->Equals(propPtr))) ||
+            (hasField && !Copy(oldPropPtr, propPtr)))
         {
             propertiesPtr->Set(name, propPtr);
+            oldPropPtr = propPtr;
         }
+        sfLoader::Get().AddStandInReferences(oldPropPtr);
+        SetContentHash(uobjPtr, propertiesPtr, upropPtr, hash);
     }
 }
 
@@ -752,12 +1755,27 @@ void sfPropertyUtil::CleanUp()
     RehashProperties();
     BroadcastChangeEvents();
     m_localChangedProperties.Empty();
+    m_throttleTimes.Empty();
+    m_deferredProperties.Empty();
+    m_schemaVersions.Empty();
+    ClearSyncPlans();
+    ClearStringCache();
+    sfSession::SPtr sessionPtr = SceneFusion::Service->Session();
+    for (sfObject::SPtr objPtr : m_templateObjects)
+    {
+        if (sessionPtr != nullptr && objPtr->IsSyncing())
+        {
+            sessionPtr->Delete(objPtr);
+        }
+    }
+    m_templateObjects.clear();
 }
 
 // private functions
 
 void sfPropertyUtil::Initialize()
 {
+    m_initialized = true;
     CreateTypeHandler<UBoolProperty>();
     CreateTypeHandler<UFloatProperty>();
     CreateTypeHandler<UIntProperty>();
@@ -783,19 +1801,47 @@ void sfPropertyUtil::Initialize()
     CreateTypeHandler(USoftObjectProperty::StaticClass(), &GetSoftObject, &SetSoftObject);
     CreateTypeHandler(UClassProperty::StaticClass(), &GetClass, &SetClass);
     CreateTypeHandler(USoftClassProperty::StaticClass(), &GetSoftClass, &SetSoftClass);
+
+    RegisterBlittableStruct("Vector");
+    RegisterBlittableStruct("Vector2D");
+    RegisterBlittableStruct("Vector4");
+    RegisterBlittableStruct("IntPoint");
+    RegisterBlittableStruct("IntVector");
+    RegisterBlittableStruct("Rotator");
+    RegisterBlittableStruct("Quat");
+    RegisterBlittableStruct("Transform");
+    RegisterBlittableStruct("Color");
+    RegisterBlittableStruct("LinearColor");
+    RegisterBlittableStruct("Box");
+    RegisterBlittableStruct("Box2D");
+
+    m_locationPropPtr = FindField<UProperty>(USceneComponent::StaticClass(), FName(sfProp::Location->c_str()));
+    m_rotationPropPtr = FindField<UProperty>(USceneComponent::StaticClass(), FName(sfProp::Rotation->c_str()));
+    m_scalePropPtr = FindField<UProperty>(USceneComponent::StaticClass(), FName(sfProp::Scale->c_str()));
 }
 
 void sfPropertyUtil::CreateTypeHandler(UClass* typePtr, TypeHandler::Getter getter, TypeHandler::Setter setter)
 {
-    int key = typePtr->GetFName().GetComparisonIndex();
-    if (m_typeHandlers.find(key) != m_typeHandlers.end())
+    int tag = GetTypeTag(typePtr);
+    if (tag < 0)
+    {
+        KS::Log::Error("Cannot create handler for type " + std::string(TCHAR_TO_UTF8(*typePtr->GetName())) +
+            ". It does not have a unique cast flag.", LOG_CHANNEL);
+        return;
+    }
+    if (m_typeHandlers[tag].Get != nullptr)
     {
         KS::Log::Warning("Duplicate handler for type " + std::string(TCHAR_TO_UTF8(*typePtr->GetName())), LOG_CHANNEL);
     }
-    m_typeHandlers.emplace(key, TypeHandler(getter, setter));
+    m_typeHandlers[tag] = TypeHandler(getter, setter);
 }
 
 bool sfPropertyUtil::IsSyncable(UObject* uobjPtr, UProperty* upropPtr)
+{
+    return IsSyncableForClass(uobjPtr->GetClass(), upropPtr);
+}
+
+bool sfPropertyUtil::IsSyncableForClass(UClass* classPtr, UProperty* upropPtr)
 {
     if (IsPropertyInForceSyncList(upropPtr))
     {
@@ -804,7 +1850,7 @@ bool sfPropertyUtil::IsSyncable(UObject* uobjPtr, UProperty* upropPtr)
 
     uint64_t flags = upropPtr->PropertyFlags;
     return flags & CPF_Edit &&
-        (!(flags & CPF_DisableEditOnInstance) || m_syncDefaultOnlyList.Contains(uobjPtr->GetClass()->GetFName()))
+        (!(flags & CPF_DisableEditOnInstance) || m_syncDefaultOnlyList.Contains(classPtr->GetFName()))
         && !(flags & CPF_EditConst);
 }
 
@@ -818,6 +1864,32 @@ bool sfPropertyUtil::IsPropertyInForceSyncList(UProperty* upropPtr)
     return m_forceSyncList.Contains(TPair<FName, FName>(ownerClassPtr->GetFName(), upropPtr->GetFName()));
 }
 
+float sfPropertyUtil::GetSyncInterval(UClass* classPtr, UProperty* upropPtr)
+{
+    UClass* ownerClassPtr = upropPtr->GetOwnerClass();
+    if (ownerClassPtr != nullptr)
+    {
+        float* intervalPtr = m_propertySyncIntervals.Find(
+            TPair<FName, FName>(ownerClassPtr->GetFName(), upropPtr->GetFName()));
+        if (intervalPtr != nullptr)
+        {
+            return *intervalPtr;
+        }
+    }
+    if (m_classSyncIntervals.Num() > 0)
+    {
+        for (UClass* currentPtr = classPtr; currentPtr != nullptr; currentPtr = currentPtr->GetSuperClass())
+        {
+            float* intervalPtr = m_classSyncIntervals.Find(currentPtr->GetFName());
+            if (intervalPtr != nullptr)
+            {
+                return *intervalPtr;
+            }
+        }
+    }
+    return sfConfig::Get().PropertySyncInterval;
+}
+
 void sfPropertyUtil::OnUPropertyChange(UObject* uobjPtr, FPropertyChangedEvent& ev)
 {
     // Objects in the transient package are non-saved objects we don't sync unless we registered a special handler
@@ -832,8 +1904,20 @@ void sfPropertyUtil::OnUPropertyChange(UObject* uobjPtr, FPropertyChangedEvent&
     if (IsSyncable(uobjPtr, ev.MemberProperty))
     {
         // Sliding values in the details panel can generate nearly 1000 change events per second, so to throttle the
-        // update rate we queue the property to be processed at most once per tick.
-        m_localChangedProperties.Add(TPair<UObject*, UProperty*>(uobjPtr, ev.MemberProperty));
+        // update rate we queue the property to be processed at most once per tick. Interactive changes are further
+        // throttled by the property's sync interval. Any non-interactive change, such as releasing the slider, is
+        // sent on the next tick.
+        TPair<UObject*, UProperty*> key(uobjPtr, ev.MemberProperty);
+        bool interactive = ev.ChangeType == EPropertyChangeType::Interactive;
+        bool* interactivePtr = m_localChangedProperties.Find(key);
+        if (interactivePtr != nullptr)
+        {
+            *interactivePtr &= interactive;
+        }
+        else
+        {
+            m_localChangedProperties.Add(key, interactive);
+        }
     }
 }
 
@@ -898,7 +1982,7 @@ bool sfPropertyUtil::SetFText(const sfUPropertyInstance& upropInstance, sfProper
 
 sfProperty::SPtr sfPropertyUtil::GetFName(const sfUPropertyInstance& upropInstance)
 {
-    return FromString(((FName*)upropInstance.Data())->ToString());
+    return FromName(*(FName*)upropInstance.Data());
 }
 
 bool sfPropertyUtil::SetFName(const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
@@ -938,18 +2022,26 @@ bool sfPropertyUtil::SetEnum(const sfUPropertyInstance& upropInstance, sfPropert
 
 sfProperty::SPtr sfPropertyUtil::GetArray(const sfUPropertyInstance& upropInstance)
 {
-    UArrayProperty* tPtr = Cast<UArrayProperty>(upropInstance.Property());
-    auto iter = m_typeHandlers.find(tPtr->Inner->GetClass()->GetFName().GetComparisonIndex());
-    if (iter == m_typeHandlers.end())
+    UArrayProperty* tPtr = static_cast<UArrayProperty*>(upropInstance.Property());
+    const TypeHandler* handlerPtr = GetTypeHandler(tPtr->Inner);
+    if (handlerPtr == nullptr)
     {
         return nullptr;
     }
-    sfListProperty::SPtr listPtr = sfListProperty::Create();
     FScriptArrayHelper array(tPtr, upropInstance.Data());
+    if (sfConfig::Get().PackedArrays && CanPack(tPtr->Inner))
+    {
+        UStructProperty* structPropPtr = Cast<UStructProperty>(tPtr->Inner);
+        if (structPropPtr == nullptr || IsBlittable(structPropPtr->Struct))
+        {
+            return GetPackedArray(tPtr, array);
+        }
+    }
+    sfListProperty::SPtr listPtr = sfListProperty::Create();
     for (int i = 0; i < array.Num(); i++)
     {
 
-        sfProperty::SPtr elementPtr = iter->second.Get(sfUPropertyInstance(tPtr->Inner, (void*)array.GetRawPtr(i)));
+        sfProperty::SPtr elementPtr = handlerPtr->Get(sfUPropertyInstance(tPtr->Inner, (void*)array.GetRawPtr(i)));
         if (elementPtr == nullptr)
         {
             return nullptr;
@@ -961,40 +2053,202 @@ sfProperty::SPtr sfPropertyUtil::GetArray(const sfUPropertyInstance& upropInstan
 
 bool sfPropertyUtil::SetArray(const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
 {
-    UArrayProperty* tPtr = Cast<UArrayProperty>(upropInstance.Property());
-    auto iter = m_typeHandlers.find(tPtr->Inner->GetClass()->GetFName().GetComparisonIndex());
-    if (iter == m_typeHandlers.end())
+    UArrayProperty* tPtr = static_cast<UArrayProperty*>(upropInstance.Property());
+    const TypeHandler* handlerPtr = GetTypeHandler(tPtr->Inner);
+    if (handlerPtr == nullptr)
     {
         return false;
     }
-    bool changed = false;
-    sfListProperty::SPtr listPtr = propPtr->AsList();
     FScriptArrayHelper array(tPtr, upropInstance.Data());
+    if (IsPackedSlice(tPtr->Inner, propPtr))
+    {
+        // A single slice changed. Only its range of elements is set.
+        return SetPackedSlice(tPtr, array, propPtr);
+    }
+    if (propPtr->Type() != sfProperty::LIST)
+    {
+        return false;
+    }
+    sfListProperty::SPtr listPtr = propPtr->AsList();
+    if (IsPackedList(tPtr->Inner, listPtr))
+    {
+        return SetPackedArray(tPtr, array, listPtr);
+    }
+    bool changed = false;
     if (array.Num() != listPtr->Size())
     {
         array.Resize(listPtr->Size());
         changed = true;
     }
-    for (int i = 0; i < listPtr->Size(); i++)
+    for (int i = 0; i < listPtr->Size(); i++)
+    {
+        if (handlerPtr->Set(sfUPropertyInstance(tPtr->Inner, (void*)array.GetRawPtr(i)), listPtr->Get(i)))
+        {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+sfProperty::SPtr sfPropertyUtil::GetPackedArray(UArrayProperty* arrayPropPtr, FScriptArrayHelper& array)
+{
+    sfListProperty::SPtr listPtr = sfListProperty::Create();
+    uint8_t packedType = GetPackedType(arrayPropPtr->Inner);
+    int elementSize = arrayPropPtr->Inner->ElementSize;
+    int capacity = GetPackedSliceCapacity(arrayPropPtr->Inner);
+    UStructProperty* structPropPtr = Cast<UStructProperty>(arrayPropPtr->Inner);
+    for (int i = 0; i < array.Num(); i += capacity)
+    {
+        int length = FMath::Min(capacity, array.Num() - i);
+        if (structPropPtr != nullptr)
+        {
+            std::vector<uint8_t> data(length * elementSize, 0);
+            for (int j = 0; j < length; j++)
+            {
+                CopyStructWithoutPadding(structPropPtr->Struct, array.GetRawPtr(i + j), data.data() + j * elementSize);
+            }
+            listPtr->Add(sfValueProperty::Create(ksMultiType(packedType, data, (int)data.size())));
+            continue;
+        }
+        // Byte arrays count bytes. Other typed arrays count elements.
+        listPtr->Add(sfValueProperty::Create(ksMultiType(packedType, (const uint8_t*)array.GetRawPtr(i),
+            length * elementSize, packedType == ksMultiType::BYTE_ARRAY ? length * elementSize : length)));
+    }
+    return listPtr;
+}
+
+bool sfPropertyUtil::SetPackedArray(
+    UArrayProperty* arrayPropPtr,
+    FScriptArrayHelper& array,
+    sfListProperty::SPtr listPtr)
+{
+    uint8_t packedType = GetPackedType(arrayPropPtr->Inner);
+    int elementSize = arrayPropPtr->Inner->ElementSize;
+    int capacity = GetPackedSliceCapacity(arrayPropPtr->Inner);
+    int numElements = 0;
+    for (int i = 0; i < listPtr->Size(); i++)
+    {
+        int length = GetPackedSliceLength(packedType, elementSize, listPtr->Get(i));
+        // Every slice but the last is full
+        if (length < 0 || length > capacity || (length < capacity && i < listPtr->Size() - 1))
+        {
+            KS::Log::Error("Error setting packed array " + std::string(TCHAR_TO_UTF8(*arrayPropPtr->GetName())) +
+                ". Slice " + std::to_string(i) + " is not a valid slice of " + std::to_string(capacity) +
+                " elements.", LOG_CHANNEL);
+            return false;
+        }
+        numElements += length;
+    }
+    bool changed = false;
+    if (array.Num() != numElements)
+    {
+        array.Resize(numElements);
+        changed = true;
+    }
+    for (int i = 0; i < listPtr->Size(); i++)
+    {
+        if (CopySlice(listPtr->Get(i), array, i * capacity, elementSize))
+        {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool sfPropertyUtil::SetPackedSlice(UArrayProperty* arrayPropPtr, FScriptArrayHelper& array, sfProperty::SPtr slicePtr)
+{
+    int elementSize = arrayPropPtr->Inner->ElementSize;
+    int length = GetPackedSliceLength(GetPackedType(arrayPropPtr->Inner), elementSize, slicePtr);
+    int elementIndex = slicePtr->Index() * GetPackedSliceCapacity(arrayPropPtr->Inner);
+    if (length < 0 || elementIndex + length > array.Num())
+    {
+        // The slice doesn't line up with the array. Set the whole array from the slice list.
+        sfProperty::SPtr listPtr = slicePtr->GetParentProperty();
+        return listPtr != nullptr && listPtr->Type() == sfProperty::LIST &&
+            SetPackedArray(arrayPropPtr, array, listPtr->AsList());
+    }
+    return CopySlice(slicePtr, array, elementIndex, elementSize);
+}
+
+bool sfPropertyUtil::InsertPackedSlices(
+    UArrayProperty* arrayPropPtr,
+    FScriptArrayHelper& array,
+    sfListProperty::SPtr listPtr,
+    int index,
+    int count)
+{
+    uint8_t packedType = GetPackedType(arrayPropPtr->Inner);
+    int elementSize = arrayPropPtr->Inner->ElementSize;
+    int elementIndex = index * GetPackedSliceCapacity(arrayPropPtr->Inner);
+    int numElements = 0;
+    for (int i = index; i < index + count; i++)
+    {
+        int length = GetPackedSliceLength(packedType, elementSize, listPtr->Get(i));
+        if (length < 0)
+        {
+            return false;
+        }
+        numElements += length;
+    }
+    if (elementIndex > array.Num())
+    {
+        return false;
+    }
+    array.InsertValues(elementIndex, numElements);
+    for (int i = index; i < index + count; i++)
+    {
+        CopySlice(listPtr->Get(i), array, elementIndex, elementSize);
+        elementIndex += (int)listPtr->Get(i)->AsValue()->GetValue().GetData().size() / elementSize;
+    }
+    return true;
+}
+
+bool sfPropertyUtil::RemovePackedSlices(
+    UArrayProperty* arrayPropPtr,
+    FScriptArrayHelper& array,
+    sfListProperty::SPtr listPtr,
+    int index,
+    int count)
+{
+    int capacity = GetPackedSliceCapacity(arrayPropPtr->Inner);
+    int elementIndex = index * capacity;
+    // Only the last slice can be partial, so removing it removes everything after the index. Other removed slices are
+    // full.
+    int numElements = index == listPtr->Size() ? array.Num() - elementIndex : count * capacity;
+    if (numElements < 0 || elementIndex + numElements > array.Num())
+    {
+        return false;
+    }
+    array.RemoveValues(elementIndex, numElements);
+    return true;
+}
+
+bool sfPropertyUtil::CopySlice(sfProperty::SPtr slicePtr, FScriptArrayHelper& array, int elementIndex, int elementSize)
+{
+    const std::vector<uint8_t>& data = slicePtr->AsValue()->GetValue().GetData();
+    if (data.empty())
+    {
+        return false;
+    }
+    uint8_t* dataPtr = (uint8_t*)array.GetRawPtr(elementIndex);
+    if (std::memcmp(dataPtr, data.data(), data.size()) == 0)
     {
-        if (iter->second.Set(sfUPropertyInstance(tPtr->Inner, (void*)array.GetRawPtr(i)), listPtr->Get(i)))
-        {
-            changed = true;
-        }
+        return false;
     }
-    return changed;
+    std::memcpy(dataPtr, data.data(), data.size());
+    return true;
 }
 
 sfProperty::SPtr sfPropertyUtil::GetMap(const sfUPropertyInstance& upropInstance)
 {
-    UMapProperty* tPtr = Cast<UMapProperty>(upropInstance.Property());
-    auto keyIter = m_typeHandlers.find(tPtr->KeyProp->GetClass()->GetFName().GetComparisonIndex());
-    if (keyIter == m_typeHandlers.end())
+    UMapProperty* tPtr = static_cast<UMapProperty*>(upropInstance.Property());
+    const TypeHandler* keyHandlerPtr = GetTypeHandler(tPtr->KeyProp);
+    if (keyHandlerPtr == nullptr)
     {
         return nullptr;
     }
-    auto valueIter = m_typeHandlers.find(tPtr->ValueProp->GetClass()->GetFName().GetComparisonIndex());
-    if (valueIter == m_typeHandlers.end())
+    const TypeHandler* valueHandlerPtr = GetTypeHandler(tPtr->ValueProp);
+    if (valueHandlerPtr == nullptr)
     {
         return nullptr;
     }
@@ -1007,12 +2261,12 @@ sfProperty::SPtr sfPropertyUtil::GetMap(const sfUPropertyInstance& upropInstance
             continue;
         }
         sfListProperty::SPtr pairPtr = sfListProperty::Create();
-        sfProperty::SPtr keyPtr = keyIter->second.Get(sfUPropertyInstance(tPtr->KeyProp, (void*)map.GetKeyPtr(i)));
+        sfProperty::SPtr keyPtr = keyHandlerPtr->Get(sfUPropertyInstance(tPtr->KeyProp, (void*)map.GetKeyPtr(i)));
         if (keyPtr == nullptr)
         {
             return nullptr;
         }
-        sfProperty::SPtr valuePtr = valueIter->second.Get(
+        sfProperty::SPtr valuePtr = valueHandlerPtr->Get(
             sfUPropertyInstance(tPtr->ValueProp, (void*)map.GetValuePtr(i)));
         if (valuePtr == nullptr)
         {
@@ -1027,56 +2281,84 @@ sfProperty::SPtr sfPropertyUtil::GetMap(const sfUPropertyInstance& upropInstance
 
 bool sfPropertyUtil::SetMap(const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
 {
-    UMapProperty* tPtr = Cast<UMapProperty>(upropInstance.Property());
-    auto keyIter = m_typeHandlers.find(tPtr->KeyProp->GetClass()->GetFName().GetComparisonIndex());
-    if (keyIter == m_typeHandlers.end())
+    UMapProperty* tPtr = static_cast<UMapProperty*>(upropInstance.Property());
+    const TypeHandler* keyHandlerPtr = GetTypeHandler(tPtr->KeyProp);
+    if (keyHandlerPtr == nullptr)
     {
         return false;
     }
-    auto valueIter = m_typeHandlers.find(tPtr->ValueProp->GetClass()->GetFName().GetComparisonIndex());
-    if (valueIter == m_typeHandlers.end())
+    const TypeHandler* valueHandlerPtr = GetTypeHandler(tPtr->ValueProp);
+    if (valueHandlerPtr == nullptr)
     {
         return false;
     }
-    bool changed = false;
-    bool changedKey = false;
     sfListProperty::SPtr listPtr = propPtr->AsList();
     FScriptMapHelper map(tPtr, upropInstance.Data());
-    if (map.Num() != listPtr->Size())
+    bool changed = false;
+    bool changedKey = false;
+    bool changedLayout = false;
+    // Pairs are synced in sparse index order. New pairs are only added in order if there are no free indexes for them
+    // to fill, so if there are we rebuild the map.
+    if (listPtr->Size() > map.Num() && map.Num() != map.GetMaxIndex())
     {
-        changed = true;
-        changedKey = true;
         map.EmptyValues(listPtr->Size());
+        changed = true;
+        changedLayout = true;
     }
-    for (int i = 0; i < listPtr->Size(); i++)
+    // Update existing pairs in place and remove pairs past the end of the list
+    int index = 0;
+    for (int i = 0; i < map.GetMaxIndex(); i++)
     {
-        if (map.Num() < listPtr->Size())
+        if (!map.IsValidIndex(i))
+        {
+            continue;
+        }
+        if (index >= listPtr->Size())
         {
-            map.AddDefaultValue_Invalid_NeedsRehash();
+            map.RemoveAt(i);
+            changed = true;
+            changedLayout = true;
+            continue;
         }
-        sfListProperty::SPtr pairPtr = listPtr->Get(i)->AsList();
-        if (keyIter->second.Set(sfUPropertyInstance(tPtr->KeyProp, (void*)map.GetKeyPtr(i)), pairPtr->Get(0)))
+        sfListProperty::SPtr pairPtr = listPtr->Get(index)->AsList();
+        index++;
+        if (keyHandlerPtr->Set(sfUPropertyInstance(tPtr->KeyProp, (void*)map.GetKeyPtr(i)), pairPtr->Get(0)))
         {
             changed = true;
             changedKey = true;
         }
-        if (valueIter->second.Set(sfUPropertyInstance(tPtr->ValueProp, (void*)map.GetValuePtr(i)), pairPtr->Get(1)))
+        if (valueHandlerPtr->Set(sfUPropertyInstance(tPtr->ValueProp, (void*)map.GetValuePtr(i)), pairPtr->Get(1)))
         {
             changed = true;
         }
     }
+    // Add new pairs
+    for (; index < listPtr->Size(); index++)
+    {
+        int i = map.AddDefaultValue_Invalid_NeedsRehash();
+        sfListProperty::SPtr pairPtr = listPtr->Get(index)->AsList();
+        keyHandlerPtr->Set(sfUPropertyInstance(tPtr->KeyProp, (void*)map.GetKeyPtr(i)), pairPtr->Get(0));
+        valueHandlerPtr->Set(sfUPropertyInstance(tPtr->ValueProp, (void*)map.GetValuePtr(i)), pairPtr->Get(1));
+        changed = true;
+        changedKey = true;
+        changedLayout = true;
+    }
     if (changedKey)
     {
         map.Rehash();
     }
+    if (changedLayout)
+    {
+        InvalidateSparseIndexes(upropInstance.Data());
+    }
     return changed;
 }
 
 sfProperty::SPtr sfPropertyUtil::GetSet(const sfUPropertyInstance& upropInstance)
 {
-    USetProperty* tPtr = Cast<USetProperty>(upropInstance.Property());
-    auto iter = m_typeHandlers.find(tPtr->ElementProp->GetClass()->GetFName().GetComparisonIndex());
-    if (iter == m_typeHandlers.end())
+    USetProperty* tPtr = static_cast<USetProperty*>(upropInstance.Property());
+    const TypeHandler* handlerPtr = GetTypeHandler(tPtr->ElementProp);
+    if (handlerPtr == nullptr)
     {
         return nullptr;
     }
@@ -1088,7 +2370,7 @@ sfProperty::SPtr sfPropertyUtil::GetSet(const sfUPropertyInstance& upropInstance
         {
             continue;
         }
-        sfProperty::SPtr elementPtr = iter->second.Get(
+        sfProperty::SPtr elementPtr = handlerPtr->Get(
             sfUPropertyInstance(tPtr->ElementProp, (void*)set.GetElementPtr(i)));
         if (elementPtr == nullptr)
         {
@@ -1101,41 +2383,81 @@ sfProperty::SPtr sfPropertyUtil::GetSet(const sfUPropertyInstance& upropInstance
 
 bool sfPropertyUtil::SetSet(const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
 {
-    USetProperty* tPtr = Cast<USetProperty>(upropInstance.Property());
-    auto iter = m_typeHandlers.find(tPtr->ElementProp->GetClass()->GetFName().GetComparisonIndex());
-    if (iter == m_typeHandlers.end())
+    USetProperty* tPtr = static_cast<USetProperty*>(upropInstance.Property());
+    const TypeHandler* handlerPtr = GetTypeHandler(tPtr->ElementProp);
+    if (handlerPtr == nullptr)
     {
         return false;
     }
-    bool changed = false;
     sfListProperty::SPtr listPtr = propPtr->AsList();
     FScriptSetHelper set(tPtr, upropInstance.Data());
-    if (set.Num() != listPtr->Size())
+    bool changed = false;
+    bool changedLayout = false;
+    // Elements are synced in sparse index order. New elements are only added in order if there are no free indexes
+    // for them to fill, so if there are we rebuild the set.
+    if (listPtr->Size() > set.Num() && set.Num() != set.GetMaxIndex())
     {
-        changed = true;
         set.EmptyElements(listPtr->Size());
+        changed = true;
+        changedLayout = true;
     }
-    for (int i = 0; i < listPtr->Size(); i++)
+    // Update existing elements in place and remove elements past the end of the list
+    int index = 0;
+    for (int i = 0; i < set.GetMaxIndex(); i++)
     {
-        if (set.Num() < listPtr->Size())
+        if (!set.IsValidIndex(i))
         {
-            set.AddDefaultValue_Invalid_NeedsRehash();
+            continue;
+        }
+        if (index >= listPtr->Size())
+        {
+            set.RemoveAt(i);
+            changed = true;
+            changedLayout = true;
+            continue;
         }
-        if (iter->second.Set(sfUPropertyInstance(tPtr->ElementProp, (void*)set.GetElementPtr(i)), listPtr->Get(i)))
+        if (handlerPtr->Set(sfUPropertyInstance(tPtr->ElementProp, (void*)set.GetElementPtr(i)), listPtr->Get(index)))
         {
             changed = true;
         }
+        index++;
+    }
+    // Add new elements
+    for (; index < listPtr->Size(); index++)
+    {
+        int i = set.AddDefaultValue_Invalid_NeedsRehash();
+        handlerPtr->Set(sfUPropertyInstance(tPtr->ElementProp, (void*)set.GetElementPtr(i)), listPtr->Get(index));
+        changed = true;
+        changedLayout = true;
     }
     if (changed)
     {
         set.Rehash();
     }
+    if (changedLayout)
+    {
+        InvalidateSparseIndexes(upropInstance.Data());
+    }
     return changed;
 }
 
 sfProperty::SPtr sfPropertyUtil::GetStruct(const sfUPropertyInstance& upropInstance)
 {
-    UStructProperty* tPtr = Cast<UStructProperty>(upropInstance.Property());
+    UStructProperty* tPtr = static_cast<UStructProperty*>(upropInstance.Property());
+    if (sfConfig::Get().QuantizeTransforms)
+    {
+        sfValueProperty::SPtr quantizedPtr = GetQuantizedTransform(upropInstance);
+        if (quantizedPtr != nullptr)
+        {
+            return quantizedPtr;
+        }
+    }
+    if (IsBlittable(tPtr->Struct))
+    {
+        std::vector<uint8_t> data(tPtr->Struct->GetStructureSize(), 0);
+        CopyStructWithoutPadding(tPtr->Struct, upropInstance.Data(), data.data());
+        return sfValueProperty::Create(ksMultiType(ksMultiType::BYTE_ARRAY, data, (int)data.size()));
+    }
     sfDictionaryProperty::SPtr dictPtr = sfDictionaryProperty::Create();
     UField* fieldPtr = tPtr->Struct->Children;
     while (fieldPtr)
@@ -1143,10 +2465,10 @@ sfProperty::SPtr sfPropertyUtil::GetStruct(const sfUPropertyInstance& upropInsta
         UProperty* subPropPtr = Cast<UProperty>(fieldPtr);
         if (subPropPtr != nullptr)
         {
-            auto iter = m_typeHandlers.find(subPropPtr->GetClass()->GetFName().GetComparisonIndex());
-            if (iter != m_typeHandlers.end())
+            const TypeHandler* handlerPtr = GetTypeHandler(subPropPtr);
+            if (handlerPtr != nullptr)
             {
-                sfProperty::SPtr valuePtr = iter->second.Get(
+                sfProperty::SPtr valuePtr = handlerPtr->Get(
                     sfUPropertyInstance(subPropPtr, subPropPtr->ContainerPtrToValuePtr<void>(upropInstance.Data())));
                 if (valuePtr != nullptr)
                 {
@@ -1162,7 +2484,41 @@ sfProperty::SPtr sfPropertyUtil::GetStruct(const sfUPropertyInstance& upropInsta
 
 bool sfPropertyUtil::SetStruct(const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
 {
-    UStructProperty* tPtr = Cast<UStructProperty>(upropInstance.Property());
+    UStructProperty* tPtr = static_cast<UStructProperty*>(upropInstance.Property());
+    if (propPtr->Type() == sfProperty::VALUE)
+    {
+        // Raw struct bytes. We accept these even if blittable structs are disabled locally, as long as the struct is
+        // plain old data and the sizes match.
+        const ksMultiType& value = propPtr->AsValue()->GetValue();
+        int size = tPtr->Struct->GetStructureSize();
+        const uint8_t* dataPtr = value.GetData().data();
+        size_t dataSize = value.GetData().size();
+        // Quantized transforms are smaller than the raw structs. Transform structs are all the size of a vector.
+        alignas(FVector) uint8_t decoded[sizeof(FVector)];
+        if (dataSize != (size_t)size && DecodeQuantizedTransform(tPtr, value, decoded))
+        {
+            dataPtr = decoded;
+            dataSize = sizeof(decoded);
+        }
+        if (!(tPtr->Struct->StructFlags & STRUCT_IsPlainOldData) || dataSize != (size_t)size)
+        {
+            KS::Log::Error("Error setting struct property " +
+                std::string(TCHAR_TO_UTF8(*upropInstance.Property()->GetName())) + ". Expected a dictionary or " +
+                std::to_string(size) + " bytes of plain old data, but got " +
+                std::to_string(value.GetData().size()) + " bytes.", LOG_CHANNEL);
+            return false;
+        }
+        if (std::memcmp(upropInstance.Data(), dataPtr, size) != 0)
+        {
+            std::memcpy(upropInstance.Data(), dataPtr, size);
+            return true;
+        }
+        return false;
+    }
+    if (propPtr->Type() != sfProperty::DICTIONARY)
+    {
+        return false;
+    }
     sfDictionaryProperty::SPtr dictPtr = propPtr->AsDict();
     UField* fieldPtr = tPtr->Struct->Children;
     bool changed = false;
@@ -1171,12 +2527,12 @@ bool sfPropertyUtil::SetStruct(const sfUPropertyInstance& upropInstance, sfPrope
         UProperty* subPropPtr = Cast<UProperty>(fieldPtr);
         if (subPropPtr != nullptr)
         {
-            auto iter = m_typeHandlers.find(subPropPtr->GetClass()->GetFName().GetComparisonIndex());
-            if (iter != m_typeHandlers.end())
+            const TypeHandler* handlerPtr = GetTypeHandler(subPropPtr);
+            if (handlerPtr != nullptr)
             {
                 std::string name = TCHAR_TO_UTF8(*subPropPtr->GetName());
                 sfProperty::SPtr valuePtr;
-                if (dictPtr->TryGet(name, valuePtr) && iter->second.Set(sfUPropertyInstance(subPropPtr,
+                if (dictPtr->TryGet(name, valuePtr) && handlerPtr->Set(sfUPropertyInstance(subPropPtr,
                     subPropPtr->ContainerPtrToValuePtr<void>(upropInstance.Data())), valuePtr))
                 {
                     changed = true;
@@ -1188,6 +2544,46 @@ bool sfPropertyUtil::SetStruct(const sfUPropertyInstance& upropInstance, sfPrope
     return changed;
 }
 
+sfValueProperty::SPtr sfPropertyUtil::GetQuantizedTransform(const sfUPropertyInstance& upropInstance)
+{
+    UProperty* upropPtr = upropInstance.Property();
+    if (upropPtr == m_locationPropPtr)
+    {
+        return sfTransformCodec::EncodeLocation(*static_cast<const FVector*>(upropInstance.Data()),
+            sfConfig::Get().LocationPrecisionBits);
+    }
+    if (upropPtr == m_rotationPropPtr)
+    {
+        return sfTransformCodec::EncodeRotator(*static_cast<const FRotator*>(upropInstance.Data()));
+    }
+    if (upropPtr == m_scalePropPtr)
+    {
+        return sfTransformCodec::EncodeScale(*static_cast<const FVector*>(upropInstance.Data()));
+    }
+    return nullptr;
+}
+
+bool sfPropertyUtil::DecodeQuantizedTransform(UProperty* upropPtr, const ksMultiType& value, void* resultPtr)
+{
+    if (upropPtr == nullptr)
+    {
+        return false;
+    }
+    if (upropPtr == m_locationPropPtr)
+    {
+        return sfTransformCodec::DecodeLocation(value, *static_cast<FVector*>(resultPtr));
+    }
+    if (upropPtr == m_rotationPropPtr)
+    {
+        return sfTransformCodec::DecodeRotator(value, *static_cast<FRotator*>(resultPtr));
+    }
+    if (upropPtr == m_scalePropPtr)
+    {
+        return sfTransformCodec::DecodeScale(value, *static_cast<FVector*>(resultPtr));
+    }
+    return false;
+}
+
 sfProperty::SPtr sfPropertyUtil::GetObject(const sfUPropertyInstance& upropInstance)
 {
     UObjectProperty* tPtr = Cast<UObjectProperty>(upropInstance.Property());
@@ -1249,15 +2645,18 @@ bool sfPropertyUtil::SetObject(const sfUPropertyInstance& upropInstance, sfPrope
     UObject* assetPtr = sfLoader::Get().LoadFromCache(path);
     if (assetPtr == nullptr || !assetPtr->IsA(tPtr->PropertyClass))
     {
-        if (sfLoader::Get().IsUserIdle())
+        // Assets that were missing the last time we were in this session get stand-ins right away
+        if (sfLoader::Get().CanLoadNow() || sfStandInCache::IsMissing(path))
         {
             assetPtr = sfLoader::Get().Load(path, className);
         }
         else
         {
-            sfLoader::Get().LoadWhenIdle(propPtr);
+            sfLoader::Get().LoadLater(propPtr);
         }
     }
+    // Index the property if the asset is missing so the stand-in can be replaced when the asset is available
+    sfLoader::Get().AddStandInReferences(propPtr);
     if (assetPtr != nullptr && assetPtr != oldPtr)
     {
         tPtr->SetObjectPropertyValue(upropInstance.Data(), assetPtr);
@@ -1346,6 +2745,7 @@ bool sfPropertyUtil::SetSoftObject(const sfUPropertyInstance& upropInstance, sfP
     {
         // The asset is missing. Loading it will create a stand-in.
         UObject* standInPtr = sfLoader::Get().Load(path, className);
+        sfLoader::Get().AddStandInReferences(propPtr);
         if (standInPtr != softObjectPtr.Get())
         {
             softObjectPtr = FSoftObjectPath(standInPtr);
@@ -1482,51 +2882,427 @@ bool sfPropertyUtil::SetSoftClass(const sfUPropertyInstance& upropInstance, sfPr
     return true;
 }
 
-// Compares the src list values in lock step with the dest list values. When there is a discrepancy we first check for
-// an element removal (Current src value = Next dest value). Next we check for an element insertion (Next src value =
-// Current dest value). Finally if neither of the above cases were found, we replace the current dest value with the
-// current src value.
+// Finds the ranges of elements that differ between the lists and replaces each range in the dest list. Elements that
+// were changed rather than inserted or removed are copied recursively, so only the changed parts of them are sent.
 void sfPropertyUtil::CopyList(sfListProperty::SPtr destPtr, sfListProperty::SPtr srcPtr)
 {
-    std::vector<sfProperty::SPtr> toAdd;
-    for (int i = 0; i < srcPtr->Size(); i++)
+    std::vector<ListHunk> hunks;
+    FindListHunks(destPtr, srcPtr, hunks);
+    // Hunk indexes are for the original dest list, so we track how much the applied hunks have shifted them.
+    int offset = 0;
+    for (const ListHunk& hunk : hunks)
     {
-        sfProperty::SPtr elementPtr = srcPtr->Get(i);
-        if (destPtr->Size() <= i)
+        int index = hunk.DestIndex + offset;
+        int numChanged = FMath::Min(hunk.DestCount, hunk.SrcCount);
+        for (int i = 0; i < numChanged; i++)
         {
-            toAdd.push_back(elementPtr);
-            continue;
+            sfProperty::SPtr elementPtr = srcPtr->Get(hunk.SrcIndex + i);
+            if (!Copy(destPtr->Get(index + i), elementPtr))
+            {
+                destPtr->Set(index + i, elementPtr);
+            }
         }
-        if (elementPtr->Equals(destPtr->Get(i)))
+        m_listDiffStats.Operations += numChanged;
+        m_listDiffStats.Elements += numChanged;
+        if (hunk.DestCount > numChanged)
         {
-            continue;
+            int count = hunk.DestCount - numChanged;
+            if (index + numChanged + count == destPtr->Size())
+            {
+                destPtr->Resize(index + numChanged);
+            }
+            else
+            {
+                destPtr->RemoveRange(index + numChanged, count);
+            }
+            m_listDiffStats.Operations++;
         }
-        // if the current src element matches the next next element, remove the current dest element.
-        if (destPtr->Size() > i + 1 && elementPtr->Equals(destPtr->Get(i + 1)))
+        else if (hunk.SrcCount > numChanged)
         {
-            destPtr->Remove(i);
-            continue;
+            std::vector<sfProperty::SPtr> toInsert;
+            toInsert.reserve(hunk.SrcCount - numChanged);
+            for (int i = hunk.SrcIndex + numChanged; i < hunk.SrcIndex + hunk.SrcCount; i++)
+            {
+                toInsert.push_back(srcPtr->Get(i));
+            }
+            if (index + numChanged == destPtr->Size())
+            {
+                destPtr->AddRange(toInsert);
+            }
+            else
+            {
+                destPtr->InsertRange(index + numChanged, toInsert);
+            }
+            m_listDiffStats.Operations++;
+            m_listDiffStats.Elements += (int)toInsert.size();
         }
-        // if the current dest element matches the next src element, insert the current src element.
-        if (srcPtr->Size() > i + 1 && destPtr->Get(i)->Equals(srcPtr->Get(i + 1)))
+        offset += hunk.SrcCount - hunk.DestCount;
+    }
+}
+
+void sfPropertyUtil::FindListHunks(
+    sfListProperty::SPtr destPtr,
+    sfListProperty::SPtr srcPtr,
+    std::vector<ListHunk>& hunks)
+{
+    int destSize = destPtr->Size();
+    int srcSize = srcPtr->Size();
+    std::vector<uint64_t> destHashes(destSize);
+    std::vector<uint64_t> srcHashes(srcSize);
+    for (int i = 0; i < destSize; i++)
+    {
+        destHashes[i] = HashProperty(destPtr->Get(i));
+    }
+    for (int i = 0; i < srcSize; i++)
+    {
+        srcHashes[i] = HashProperty(srcPtr->Get(i));
+    }
+    // Hashes rule out most unequal elements cheaply. We confirm matching hashes with Equals.
+    auto equals = [&](int destIndex, int srcIndex)
+    {
+        return destHashes[destIndex] == srcHashes[srcIndex] &&
+            destPtr->Get(destIndex)->Equals(srcPtr->Get(srcIndex));
+    };
+
+    // Skip the common prefix and suffix
+    int start = 0;
+    while (start < destSize && start < srcSize && equals(start, start))
+    {
+        start++;
+    }
+    int destEnd = destSize;
+    int srcEnd = srcSize;
+    while (destEnd > start && srcEnd > start && equals(destEnd - 1, srcEnd - 1))
+    {
+        destEnd--;
+        srcEnd--;
+    }
+    int n = destEnd - start;
+    int m = srcEnd - start;
+    if (n == 0 && m == 0)
+    {
+        return;
+    }
+
+    // Myers' greedy algorithm. v[k + offset] is the furthest dest index reached on diagonal k = x - y. We keep a copy
+    // of v for each cost so we can backtrack to find the edit script.
+    int maxCost = FMath::Min(n + m, MAX_LIST_DIFF_COST);
+    int offset = maxCost + 1;
+    std::vector<int> v(2 * maxCost + 3, 0);
+    std::vector<std::vector<int>> trace;
+    bool found = false;
+    for (int d = 0; d <= maxCost && !found; d++)
+    {
+        trace.push_back(v);
+        for (int k = -d; k <= d; k += 2)
         {
-            destPtr->Insert(i, elementPtr);
-            i++;
-            continue;
+            int x;
+            if (k == -d || (k != d && v[k - 1 + offset] < v[k + 1 + offset]))
+            {
+                x = v[k + 1 + offset];// insert
+            }
+            else
+            {
+                x = v[k - 1 + offset] + 1;// remove
+            }
+            int y = x - k;
+            while (x < n && y < m && equals(start + x, start + y))
+            {
+                x++;
+                y++;
+            }
+            v[k + offset] = x;
+            if (x >= n && y >= m)
+            {
+                found = true;
+                break;
+            }
+        }
+    }
+    if (!found)
+    {
+        // Too many changes to diff. Overwrite everything between the common prefix and suffix.
+        hunks.push_back(ListHunk{ start, n, start, m });
+        return;
+    }
+
+    // Backtrack from the end to find the removed and inserted elements. Edits are added in reverse order.
+    std::vector<bool> isRemove;
+    std::vector<int> editX;
+    std::vector<int> editY;
+    int x = n;
+    int y = m;
+    for (int d = (int)trace.size() - 1; d > 0; d--)
+    {
+        const std::vector<int>& prev = trace[d];
+        int k = x - y;
+        int prevK = (k == -d || (k != d && prev[k - 1 + offset] < prev[k + 1 + offset])) ? k + 1 : k - 1;
+        int prevX = prev[prevK + offset];
+        int prevY = prevX - prevK;
+        // Skip the matching elements that follow the edit
+        x = FMath::Max(prevX, x - FMath::Min(x - prevX, y - prevY));
+        y = x - k;
+        isRemove.push_back(x != prevX);
+        editX.push_back(prevX);
+        editY.push_back(prevY);
+        x = prevX;
+        y = prevY;
+    }
+
+    // Group consecutive edits into hunks
+    for (int i = (int)isRemove.size() - 1; i >= 0; i--)
+    {
+        int editDestIndex = start + editX[i];
+        int editSrcIndex = start + editY[i];
+        if (hunks.size() == 0 ||
+            hunks.back().DestIndex + hunks.back().DestCount != editDestIndex ||
+            hunks.back().SrcIndex + hunks.back().SrcCount != editSrcIndex)
+        {
+            hunks.push_back(ListHunk{ editDestIndex, 0, editSrcIndex, 0 });
+        }
+        if (isRemove[i])
+        {
+            hunks.back().DestCount++;
+        }
+        else
+        {
+            hunks.back().SrcCount++;
+        }
+    }
+}
+
+uint64_t sfPropertyUtil::HashProperty(sfProperty::SPtr propPtr)
+{
+    const uint64_t prime = 1099511628211ull;
+    uint64_t hash = 14695981039346656037ull ^ (uint64_t)propPtr->Type();
+    switch (propPtr->Type())
+    {
+        case sfProperty::VALUE:
+        {
+            const ksMultiType& value = propPtr->AsValue()->GetValue();
+            hash = (hash ^ value.GetType()) * prime;
+            for (uint8_t byte : value.GetData())
+            {
+                hash = (hash ^ byte) * prime;
+            }
+            break;
+        }
+        case sfProperty::REFERENCE:
+        {
+            hash = (hash ^ propPtr->AsReference()->GetObjectId()) * prime;
+            break;
+        }
+        case sfProperty::LIST:
+        {
+            for (const sfProperty::SPtr& elementPtr : *propPtr->AsList())
+            {
+                hash = (hash ^ HashProperty(elementPtr)) * prime;
+            }
+            break;
+        }
+        case sfProperty::DICTIONARY:
+        {
+            // Dictionary iteration order is not defined, so we combine the fields with addition.
+            uint64_t fieldsHash = 0;
+            for (const auto& iter : *propPtr->AsDict())
+            {
+                fieldsHash += (std::hash<sfName>()(iter.first) * prime) ^ HashProperty(iter.second);
+            }
+            hash = (hash ^ fieldsHash) * prime;
+            break;
+        }
+    }
+    return hash;
+}
+
+uint64_t sfPropertyUtil::GetContentHash(UObject* uobjPtr, UProperty* upropPtr)
+{
+    uint64_t hash = 14695981039346656037ull;
+    if (!HashUPropertyValue(upropPtr, upropPtr->ContainerPtrToValuePtr<void>(uobjPtr), hash))
+    {
+        return 0;
+    }
+    // 0 means not hashable
+    return hash == 0 ? 1 : hash;
+}
+
+bool sfPropertyUtil::HashUPropertyValue(UProperty* upropPtr, void* dataPtr, uint64_t& hash)
+{
+    if (UBoolProperty* boolPropPtr = Cast<UBoolProperty>(upropPtr))
+    {
+        uint8_t value = boolPropPtr->GetPropertyValue(dataPtr) ? 1 : 0;
+        HashBytes(&value, 1, hash);
+        return true;
+    }
+    if (upropPtr->IsA<UNumericProperty>() || upropPtr->IsA<UEnumProperty>())
+    {
+        HashBytes(dataPtr, upropPtr->ElementSize, hash);
+        return true;
+    }
+    if (upropPtr->IsA<UStrProperty>() || upropPtr->IsA<UTextProperty>())
+    {
+        // Hash the length too so adjacent strings in containers cannot hash the same as different strings with the
+        // same characters.
+        const FString& str = upropPtr->IsA<UStrProperty>() ? *(FString*)dataPtr : ((FText*)dataPtr)->ToString();
+        int length = str.Len();
+        HashBytes(&length, sizeof(length), hash);
+        HashBytes(*str, length * sizeof(TCHAR), hash);
+        return true;
+    }
+    if (upropPtr->IsA<UNameProperty>())
+    {
+        // Names are synced as strings. The display index identifies the string with its case.
+        FName name = *(FName*)dataPtr;
+        NAME_INDEX index = name.GetDisplayIndex();
+        int32 number = name.GetNumber();
+        HashBytes(&index, sizeof(index), hash);
+        HashBytes(&number, sizeof(number), hash);
+        return true;
+    }
+    if (UStructProperty* structPropPtr = Cast<UStructProperty>(upropPtr))
+    {
+        if (structPropPtr->Struct->StructFlags & STRUCT_IsPlainOldData)
+        {
+            HashBytes(dataPtr, structPropPtr->Struct->GetStructureSize(), hash);
+            return true;
+        }
+        UField* fieldPtr = structPropPtr->Struct->Children;
+        while (fieldPtr)
+        {
+            UProperty* subPropPtr = Cast<UProperty>(fieldPtr);
+            // Fields without a type handler are not synced
+            if (subPropPtr != nullptr && GetTypeHandler(subPropPtr) != nullptr &&
+                !HashUPropertyValue(subPropPtr, subPropPtr->ContainerPtrToValuePtr<void>(dataPtr), hash))
+            {
+                return false;
+            }
+            fieldPtr = fieldPtr->Next;
+        }
+        return true;
+    }
+    if (UArrayProperty* arrayPropPtr = Cast<UArrayProperty>(upropPtr))
+    {
+        FScriptArrayHelper array(arrayPropPtr, dataPtr);
+        int num = array.Num();
+        HashBytes(&num, sizeof(num), hash);
+        if (num > 0 && CanPack(arrayPropPtr->Inner))
+        {
+            HashBytes(array.GetRawPtr(0), num * arrayPropPtr->Inner->ElementSize, hash);
+            return true;
+        }
+        for (int i = 0; i < num; i++)
+        {
+            if (!HashUPropertyValue(arrayPropPtr->Inner, array.GetRawPtr(i), hash))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (UMapProperty* mapPropPtr = Cast<UMapProperty>(upropPtr))
+    {
+        // Maps are synced as lists of pairs in sparse array order, so we hash them in the same order.
+        FScriptMapHelper map(mapPropPtr, dataPtr);
+        int num = map.Num();
+        HashBytes(&num, sizeof(num), hash);
+        for (int i = 0; i < map.GetMaxIndex(); i++)
+        {
+            if (map.IsValidIndex(i) && (!HashUPropertyValue(mapPropPtr->KeyProp, map.GetKeyPtr(i), hash) ||
+                !HashUPropertyValue(mapPropPtr->ValueProp, map.GetValuePtr(i), hash)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (USetProperty* setPropPtr = Cast<USetProperty>(upropPtr))
+    {
+        FScriptSetHelper set(setPropPtr, dataPtr);
+        int num = set.Num();
+        HashBytes(&num, sizeof(num), hash);
+        for (int i = 0; i < set.GetMaxIndex(); i++)
+        {
+            if (set.IsValidIndex(i) && !HashUPropertyValue(setPropPtr->ElementProp, set.GetElementPtr(i), hash))
+            {
+                return false;
+            }
         }
-        if (!Copy(destPtr->Get(i), elementPtr))
+        return true;
+    }
+    if (UObjectProperty* objPropPtr = Cast<UObjectProperty>(upropPtr))
+    {
+        return HashObjectReference(objPropPtr->GetObjectPropertyValue(dataPtr), hash);
+    }
+    if (upropPtr->IsA<USoftObjectProperty>())
+    {
+        // Soft references to loaded objects are synced like hard references, and otherwise as asset paths.
+        FSoftObjectPtr& softObjectPtr = *(FSoftObjectPtr*)dataPtr;
+        const FSoftObjectPath& path = softObjectPtr.ToSoftObjectPath();
+        FName assetPath = path.GetAssetPathName();
+        NAME_INDEX index = assetPath.GetDisplayIndex();
+        int32 number = assetPath.GetNumber();
+        HashBytes(&index, sizeof(index), hash);
+        HashBytes(&number, sizeof(number), hash);
+        const FString& subPath = path.GetSubPathString();
+        HashBytes(*subPath, subPath.Len() * sizeof(TCHAR), hash);
+        return HashObjectReference(softObjectPtr.Get(), hash);
+    }
+    return false;
+}
+
+bool sfPropertyUtil::HashObjectReference(UObject* referencePtr, uint64_t& hash)
+{
+    if (referencePtr != nullptr && (referencePtr->IsPendingKill() || referencePtr->HasAllFlags(RF_Transient)))
+    {
+        return false;
+    }
+    HashBytes(&referencePtr, sizeof(referencePtr), hash);
+    sfObject::SPtr objPtr = referencePtr == nullptr ? nullptr : sfObjectMap::GetSFObject(referencePtr);
+    uint32_t id = objPtr == nullptr ? 0 : objPtr->Id();
+    HashBytes(&id, sizeof(id), hash);
+    return true;
+}
+
+bool sfPropertyUtil::IsContentUnchanged(
+    UObject* uobjPtr,
+    sfDictionaryProperty::SPtr dictPtr,
+    UProperty* upropPtr,
+    uint64_t hash)
+{
+    if (hash != 0)
+    {
+        ContentHashes* hashesPtr = m_contentHashes.Find(uobjPtr);
+        if (hashesPtr != nullptr && hashesPtr->DictPtr == dictPtr.get())
         {
-            destPtr->Set(i, elementPtr);
+            uint64_t* oldHashPtr = hashesPtr->Hashes.Find(upropPtr);
+            if (oldHashPtr != nullptr && *oldHashPtr == hash)
+            {
+                m_contentHashStats.Hits++;
+                return true;
+            }
         }
     }
-    if (toAdd.size() > 0)
+    m_contentHashStats.Misses++;
+    return false;
+}
+
+void sfPropertyUtil::SetContentHash(
+    UObject* uobjPtr,
+    sfDictionaryProperty::SPtr dictPtr,
+    UProperty* upropPtr,
+    uint64_t hash)
+{
+    if (hash == 0)
     {
-        destPtr->AddRange(toAdd);
+        return;
     }
-    else if (destPtr->Size() > srcPtr->Size())
+    ContentHashes& hashes = m_contentHashes.FindOrAdd(uobjPtr);
+    if (hashes.DictPtr != dictPtr.get())
     {
-        destPtr->Resize(srcPtr->Size());
+        hashes.DictPtr = dictPtr.get();
+        hashes.Hashes.Empty();
     }
+    hashes.Hashes.Add(upropPtr, hash);
 }
 
 void sfPropertyUtil::CopyDict(sfDictionaryProperty::SPtr destPtr, sfDictionaryProperty::SPtr srcPtr)
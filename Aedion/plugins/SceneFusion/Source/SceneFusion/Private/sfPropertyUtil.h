@@ -5,6 +5,7 @@
 #include "sfUPropertyInstance.h"
 
 #include <CoreMinimal.h>
+#include <GameFramework/Actor.h>
 
 using namespace KS;
 using namespace KS::SceneFusion2;
@@ -23,6 +24,98 @@ public:
      */
     typedef std::function<void(UObject* uobjPtr, UProperty* upropPtr)> PropertyChangeHandler;
 
+    /**
+     * Counts of the list operations made by Copy when updating list properties.
+     */
+    struct ListDiffStats
+    {
+    public:
+        /**
+         * Number of set, insert and remove operations.
+         */
+        int Operations = 0;
+
+        /**
+         * Number of elements sent by set and insert operations.
+         */
+        int Elements = 0;
+    };
+
+    /**
+     * Counts of properties checked against the content hash of the value they had when they were last synced.
+     */
+    struct ContentHashStats
+    {
+    public:
+        /**
+         * Number of properties skipped because their value was unchanged.
+         */
+        int Hits = 0;
+
+        /**
+         * Number of properties that changed, were not synced before, or could not be hashed.
+         */
+        int Misses = 0;
+    };
+
+    /**
+     * Counts of locally changed properties that were sent or held back by the sync interval throttle.
+     */
+    struct ThrottleStats
+    {
+    public:
+        /**
+         * Number of property changes sent.
+         */
+        int Sent = 0;
+
+        /**
+         * Number of interactive property changes that were held back because the property was sent too recently.
+         */
+        int Suppressed = 0;
+    };
+
+    /**
+     * Counts of change events broadcast for properties changed by other users.
+     */
+    struct ChangeEventStats
+    {
+    public:
+        /**
+         * Number of PostEditChangeProperty calls.
+         */
+        int Events = 0;
+
+        /**
+         * Number of blueprint construction script runs avoided by notifying actors of all changed properties at
+         * once.
+         */
+        int ConstructionScriptRunsAvoided = 0;
+    };
+
+    /**
+     * Counts of recorded property values sent with and without templates.
+     */
+    struct TemplateStats
+    {
+    public:
+        /**
+         * Number of templates created.
+         */
+        int Templates = 0;
+
+        /**
+         * Number of non-default recorded values of created objects.
+         */
+        int Values = 0;
+
+        /**
+         * Number of recorded values sent in templates and object records. Values equal to the template value are not
+         * sent.
+         */
+        int SentValues = 0;
+    };
+
     /**
      * On get asset property event.
      *
@@ -136,6 +229,23 @@ public:
      */
     static sfValueProperty::SPtr FromString(const FString& value);
 
+    /**
+     * Constructs a string property from a name. Faster than FromString for names that were converted before, since
+     * the cached string table id is found without converting the name to a string.
+     *
+     * @param   const FName& value
+     * @return  sfValueProperty::SPtr
+     */
+    static sfValueProperty::SPtr FromName(const FName& value);
+
+    /**
+     * Gets the session string table id for a string. Ids are cached until disconnecting.
+     *
+     * @param   const FString& value
+     * @return  uint32_t
+     */
+    static uint32_t GetStringTableId(const FString& value);
+
     /**
      * Converts a property to a string.
      *
@@ -144,6 +254,15 @@ public:
      */
     static FString ToString(sfProperty::SPtr propertyPtr);
 
+    /**
+     * Looks up the string for a session string table id without adding it to the string cache.
+     *
+     * @param   uint32_t id
+     * @param   FString& str - set to the string if the id is in the string table.
+     * @return  bool true if the id is in the string table.
+     */
+    static bool TryGetStringFromTable(uint32_t id, FString& str);
+
     /**
      * Finds a uproperty of a uobject corresponding to an sfproperty.
      *
@@ -153,6 +272,16 @@ public:
      */
     static sfUPropertyInstance FindUProperty(UObject* uobjPtr, sfProperty::SPtr propPtr);
 
+    /**
+     * Checks if an sfproperty is for an object reference uproperty on a class. This only uses the class's property
+     * layout, so it works before an object of the class is created.
+     *
+     * @param   UClass* classPtr the property belongs to.
+     * @param   sfProperty::SPtr propPtr to check.
+     * @return  bool true if the corresponding uproperty is an object or soft object reference.
+     */
+    static bool IsAssetReference(UClass* classPtr, sfProperty::SPtr propPtr);
+
     /**
      * Converts a UProperty to an sfProperty using reflection.
      *
@@ -162,6 +291,14 @@ public:
      */
     static sfProperty::SPtr GetValue(UObject* uobjPtr, UProperty* upropPtr);
 
+    /**
+     * Converts a UProperty instance to an sfProperty using reflection.
+     *
+     * @param   const sfUPropertyInstance& upropInstance
+     * @return  sfProperty::SPtr
+     */
+    static sfProperty::SPtr GetValue(const sfUPropertyInstance& upropInstance);
+
     /**
      * Sets a UProperty using reflection to a value from an sfValueProperty.
      *
@@ -192,6 +329,16 @@ public:
      */
     static void SetToDefaultValue(UObject* uobjPtr, UProperty* upropPtr);
 
+    /**
+     * Sets a property on an object to its value in the property record from the object's dictionary, or to the
+     * default value if the record does not have the property. Call this when a named field is removed.
+     *
+     * @param   UObject* objPtr to set property on.
+     * @param   UProperty* upropPtr to set.
+     * @param   sfDictionaryProperty::SPtr dictPtr the property was removed from.
+     */
+    static void SetToRecordValue(UObject* uobjPtr, UProperty* upropPtr, sfDictionaryProperty::SPtr dictPtr);
+
     /**
      * Adds a property into the force to sync list.
      *
@@ -207,6 +354,117 @@ public:
      */
     static void IgnoreDisableEditOnInstanceFlagForClass(FName className);
 
+    /**
+     * Sets the minimum number of seconds between sending interactive changes, such as slider drags, to properties of
+     * a class and its subclasses. The first change is sent immediately and the last change is always sent. Overrides
+     * the PropertySyncInterval config value.
+     *
+     * @param   FName className
+     * @param   float seconds - minimum interval. 0 to send changes every tick.
+     */
+    static void SetSyncInterval(FName className, float seconds);
+
+    /**
+     * Sets the minimum number of seconds between sending interactive changes to a property. Overrides class sync
+     * intervals.
+     *
+     * @param   FName ownerClassName - name of the class that declares the property.
+     * @param   FName propertyName
+     * @param   float seconds - minimum interval. 0 to send changes every tick.
+     */
+    static void SetSyncInterval(FName ownerClassName, FName propertyName, float seconds);
+
+    /**
+     * Registers a plain-old-data struct type to be synced as raw bytes instead of as a dictionary of fields. Structs
+     * without the STRUCT_IsPlainOldData flag are always synced as dictionaries.
+     *
+     * @param   FName structName - name of the struct without the F prefix, eg. "Vector".
+     */
+    static void RegisterBlittableStruct(FName structName);
+
+    /**
+     * Checks if a struct type is synced as raw bytes.
+     *
+     * @param   UScriptStruct* structPtr to check.
+     * @return  bool true if the struct is registered as blittable, is plain old data, and blittable structs are
+     *          enabled in the config.
+     */
+    static bool IsBlittable(UScriptStruct* structPtr);
+
+    /**
+     * Checks if values of a property type can be copied as raw bytes. Numeric properties and plain-old-data structs
+     * can be. Arrays with these element types may be synced as packed arrays.
+     *
+     * @param   UProperty* upropPtr to check.
+     * @return  bool true if the property value can be copied as raw bytes.
+     */
+    static bool CanPack(UProperty* upropPtr);
+
+    /**
+     * Checks if a property is a packed slice of elements for an array with the given element property. Packed arrays
+     * are lists of typed array slices with a fixed number of elements per slice, except for the last slice which can
+     * be shorter. Always false when packed arrays are disabled in the config.
+     *
+     * @param   UProperty* elementPropPtr - array element property.
+     * @param   sfProperty::SPtr propPtr to check.
+     * @return  bool true if the property is a packed slice.
+     */
+    static bool IsPackedSlice(UProperty* elementPropPtr, sfProperty::SPtr propPtr);
+
+    /**
+     * Checks if a list is a packed array for an array with the given element property.
+     *
+     * @param   UProperty* elementPropPtr - array element property.
+     * @param   sfListProperty::SPtr listPtr to check.
+     * @return  bool true if the list holds packed slices.
+     */
+    static bool IsPackedList(UProperty* elementPropPtr, sfListProperty::SPtr listPtr);
+
+    /**
+     * Sets an array from a packed array list.
+     *
+     * @param   UArrayProperty* arrayPropPtr
+     * @param   FScriptArrayHelper& array to set.
+     * @param   sfListProperty::SPtr listPtr of packed slices.
+     * @return  bool true if the array changed.
+     */
+    static bool SetPackedArray(UArrayProperty* arrayPropPtr, FScriptArrayHelper& array, sfListProperty::SPtr listPtr);
+
+    /**
+     * Inserts the elements of a range of packed slices into an array. Slices before the range are full, so the
+     * elements are inserted at the slice index times the slice capacity.
+     *
+     * @param   UArrayProperty* arrayPropPtr
+     * @param   FScriptArrayHelper& array to insert into.
+     * @param   sfListProperty::SPtr listPtr of packed slices.
+     * @param   int index of the first inserted slice.
+     * @param   int count - number of inserted slices.
+     * @return  bool false if the slices do not line up with the array.
+     */
+    static bool InsertPackedSlices(
+        UArrayProperty* arrayPropPtr,
+        FScriptArrayHelper& array,
+        sfListProperty::SPtr listPtr,
+        int index,
+        int count);
+
+    /**
+     * Removes the elements of a range of removed packed slices from an array.
+     *
+     * @param   UArrayProperty* arrayPropPtr
+     * @param   FScriptArrayHelper& array to remove from.
+     * @param   sfListProperty::SPtr listPtr the slices were removed from.
+     * @param   int index of the first removed slice.
+     * @param   int count - number of removed slices.
+     * @return  bool false if the slices do not line up with the array.
+     */
+    static bool RemovePackedSlices(
+        UArrayProperty* arrayPropPtr,
+        FScriptArrayHelper& array,
+        sfListProperty::SPtr listPtr,
+        int index,
+        int count);
+
     /**
      * Checks if a property is syncable.
      * A UProperty can be synced if it is in the force sync set or if the CPF_Edit flag is set,
@@ -225,19 +483,41 @@ public:
      * @param   UObject* uobjPtr to create properties for.
      * @param   sfDictionaryProperty::SPtr dictPtr to add properties to.
      * @param   const TArray<FString>* const blacklistPtr - if the property name is in this list, ignore the property.
+     *          Results are cached per blacklist, so the list must not change after it is first used.
+     * @param   bool useSchema - if true, properties without object references are added as an ordered record with a
+     *          presence bitmap that refers to a schema object for the class instead of as named fields. The schema is
+     *          created the first time the class is used in the session.
      */
     static void CreateProperties(
         UObject* uobjPtr,
         sfDictionaryProperty::SPtr dictPtr,
-        const TSet<FString>* const blacklistPtr = nullptr);
+        const TSet<FString>* const blacklistPtr = nullptr,
+        bool useSchema = false);
+
+    /**
+     * Creates property templates for a batch of objects that are about to be created. For each class with at least
+     * MIN_TEMPLATE_OBJECTS objects in the batch, the most common non-default value of each recordable property is
+     * sent once in a template object if more than one object has it. CreateProperties with useSchema then refers to
+     * the template and only records values that differ from it. Call ClearTemplates after creating the objects.
+     *
+     * @param   const TArray<UObject*>& uobjects to create templates for.
+     */
+    static void CreateTemplates(const TArray<UObject*>& uobjects);
+
+    /**
+     * Stops using the templates from CreateTemplates for new objects. Template objects are not deleted until CleanUp
+     * since objects refer to them.
+     */
+    static void ClearTemplates();
 
     /**
      * Applies property values from an sfDictionaryProperty to an object using reflection.
      *
      * @param   UObject* uobjPtr to apply property values to.
      * @param   sfDictionaryProperty::SPtr dictPtr to get property values from. If a value for a property is not in the
-     *          dictionary, sets the property to its default value.
+     *          dictionary or its property record, sets the property to its default value.
      * @param   const TArray<FString>* const blacklistPtr - if the property name is in this list, ignore the property.
+     *          Results are cached per blacklist, so the list must not change after it is first used.
      */
     static void ApplyProperties(
         UObject* uobjPtr,
@@ -252,6 +532,7 @@ public:
      * @param   UObject* uobjPtr to iterate properties on.
      * @param   sfDictionaryProperty::SPtr dictPtr to update.
      * @param   const TArray<FString>* const blacklistPtr - if the property name is in this list, ignore the property.
+     *          Results are cached per blacklist, so the list must not change after it is first used.
      */
     static void SendPropertyChanges(
         UObject* uobjPtr,
@@ -275,6 +556,67 @@ public:
      */
     static bool Copy(sfProperty::SPtr destPtr, sfProperty::SPtr srcPtr);
 
+    /**
+     * Gets the counts of list operations made by Copy. Assign a new ListDiffStats to reset them.
+     *
+     * @return  ListDiffStats&
+     */
+    static ListDiffStats& GetListDiffStats()
+    {
+        return m_listDiffStats;
+    }
+
+    /**
+     * Gets the counts of properties skipped by SyncProperty and SendPropertyChanges because their content hash was
+     * unchanged. Assign a new ContentHashStats to reset them.
+     *
+     * @return  ContentHashStats&
+     */
+    static ContentHashStats& GetContentHashStats()
+    {
+        return m_contentHashStats;
+    }
+
+    /**
+     * Gets the counts of property changes sent and held back by the sync interval throttle. Assign a new
+     * ThrottleStats to reset them.
+     *
+     * @return  ThrottleStats&
+     */
+    static ThrottleStats& GetThrottleStats()
+    {
+        return m_throttleStats;
+    }
+
+    /**
+     * Gets the counts of change events broadcast by BroadcastChangeEvents. Assign a new ChangeEventStats to reset
+     * them.
+     *
+     * @return  ChangeEventStats&
+     */
+    static ChangeEventStats& GetChangeEventStats()
+    {
+        return m_changeEventStats;
+    }
+
+    /**
+     * Gets the counts of recorded values sent with and without templates. Assign a new TemplateStats to reset them.
+     *
+     * @return  TemplateStats&
+     */
+    static TemplateStats& GetTemplateStats()
+    {
+        return m_templateStats;
+    }
+
+    /**
+     * Forgets the content hashes of the last synced property values of an object. Call this when the object stops
+     * syncing so the hashes don't match a different object that reuses its address.
+     *
+     * @param   UObject* uobjPtr
+     */
+    static void ClearContentHashes(UObject* uobjPtr);
+
     /**
      * Adds a uproperty instance's containing hash to the set of hashes that need rehashing. Does nothing if the
      * uproperty instance is not a key in a hash.
@@ -283,6 +625,42 @@ public:
      */
     static void MarkHashStale(const sfUPropertyInstance& upropInstance);
 
+    /**
+     * Gets the sparse index of a map element from its index in the synced list of pairs. Sparse indexes are cached
+     * until the map is marked stale or properties are rehashed.
+     *
+     * @param   const FScriptMapHelper& map
+     * @param   int index of the pair.
+     * @return  int sparse index, or -1 if the index is out of bounds.
+     */
+    static int GetSparseIndex(const FScriptMapHelper& map, int index)
+    {
+        return FindSparseIndex(map, map.Map, index);
+    }
+
+    /**
+     * Gets the sparse index of a set element from its index in the synced list of elements. Sparse indexes are cached
+     * until the set is marked stale or properties are rehashed.
+     *
+     * @param   const FScriptSetHelper& set
+     * @param   int index of the element.
+     * @return  int sparse index, or -1 if the index is out of bounds.
+     */
+    static int GetSparseIndex(const FScriptSetHelper& set, int index)
+    {
+        return FindSparseIndex(set, set.Set, index);
+    }
+
+    /**
+     * Clears the cached sparse indexes for a map or set. Call this after adding or removing elements.
+     *
+     * @param   const void* containerPtr - FScriptMap or FScriptSet.
+     */
+    static void InvalidateSparseIndexes(const void* containerPtr)
+    {
+        m_sparseIndexes.Remove(containerPtr);
+    }
+
     /**
      * Marks a property as being changed so we will call the appropriate change events for it when BroadcastChangeEvents
      * is called.
@@ -295,7 +673,8 @@ public:
     static void MarkPropertyChanged(UObject* uobjPtr, UProperty* upropPtr, sfProperty::SPtr propPtr = nullptr);
 
     /**
-     * Rehashes property containers whose keys were changed by other users.
+     * Rehashes property containers whose keys were changed by other users, and clears cached map and set sparse
+     * indexes.
      */
     static void RehashProperties();
 
@@ -356,10 +735,16 @@ public:
         bool applyServerValue = false);
 
     /**
-     * Rehashes stale properties and broadcasts change events. Clears state.
+     * Rehashes stale properties and broadcasts change events. Clears state, including the session string cache.
      */
     static void CleanUp();
 
+    /**
+     * Clears the cached sync plans, property paths, default subobjects and content hashes. Call this when classes are
+     * recompiled or reloaded so the caches will be rebuilt from the new class layouts.
+     */
+    static void ClearSyncPlans();
+
     /**
      * Registers UProperty change handler for the given class.
      *
@@ -377,7 +762,7 @@ public:
 
 private:
     /**
-     * Holds getter and setter delegates for converting between a UProperty type and sfValueProperty.
+     * Holds getter and setter functions for converting between a UProperty type and sfValueProperty.
      */
     struct TypeHandler
     {
@@ -388,7 +773,7 @@ private:
          * @param   const sfUPropertyInstance& to get value for.
          * @return  sfProperty::SPtr
          */
-        typedef std::function<sfProperty::SPtr(const sfUPropertyInstance&)> Getter;
+        typedef sfProperty::SPtr (*Getter)(const sfUPropertyInstance&);
 
         /**
          * Sets a UProperty value using reflection to a value from an sfProperty.
@@ -397,7 +782,7 @@ private:
          * @param   sfProperty::SPtr to get value from.
          * @return  bool true if the value changed.
          */
-        typedef std::function<bool(const sfUPropertyInstance&, sfProperty::SPtr)> Setter;
+        typedef bool (*Setter)(const sfUPropertyInstance&, sfProperty::SPtr);
 
         /**
          * Getter
@@ -409,6 +794,16 @@ private:
          */
         Setter Set;
 
+        /**
+         * Constructor
+         */
+        TypeHandler() :
+            Get{ nullptr },
+            Set{ nullptr }
+        {
+
+        }
+
         /**
          * Constructor
          *
@@ -423,58 +818,528 @@ private:
         }
     };
 
-    // TMaps seem buggy and I don't trust them. Dereferencing the pointer returned by TMap.find causes an access
-    // violation, so we use std::unordered_map which works fine.
-    // Keys are UProperty class name ids.
-    static std::unordered_map<int, TypeHandler> m_typeHandlers;
-    static TMap<FScriptMap*, TSharedPtr<FScriptMapHelper>> m_staleMaps;// maps that need rehashing
-    static TMap<FScriptSet*, TSharedPtr<FScriptSetHelper>> m_staleSets;// sets that need rehashing
-    // properties changed by the server we need to fire events for
-    static TSet<TPair<UObject*, UProperty*>> m_serverChangedProperties;
-    // properties changed locally we need to process
-    static TSet<TPair<UObject*, UProperty*>> m_localChangedProperties;
-    // we don't call property change handlers on non-editable properties unless they're in the white list
-    static TSet<TPair<FName, FName>> m_forceSyncList;// key: owner class name, value: property name
-    static FDelegateHandle m_onPropertyChangeHandle;
-    static TMap<FName, PropertyChangeHandler> m_classNameToPropertyChangeHandler;
-    static TSet<FName> m_syncDefaultOnlyList;// Sync default only properties for types in this list
-    static OnGetAssetPropertyEvent m_onGetAssetProperty;
-
     /**
-     * Registers UProperty type handlers.
+     * Case-sensitive key functions for maps with string keys. The string table is case-sensitive, but the default
+     * string key functions are not.
      */
-    static void Initialize();
+    struct CaseSensitiveStringKeyFuncs : TDefaultMapKeyFuncs<FString, uint32_t, false>
+    {
+    public:
+        static bool Matches(const FString& a, const FString& b)
+        {
+            return a.Equals(b, ESearchCase::CaseSensitive);
+        }
 
-    /**
-     * Creates a property type handler.
-     *
-     * @param   UClass* typePtr to create handler for.
-     * @param   TypeHandler::Getter getter for getting properties of the given type.
-     * @param   TypeHandler::Setter setter for setting properties of the given type.
-     */
-    static void CreateTypeHandler(UClass* typePtr, TypeHandler::Getter getter, TypeHandler::Setter setter);
+        static uint32 GetKeyHash(const FString& key)
+        {
+            return FCrc::StrCrc32(*key);
+        }
+    };
 
     /**
-     * Returns true if the given UProperty is in the force to sync list.
-     *
-     * @param   UObject* uobjPtr to check
-     * @param   UProperty* upropPtr to check
-     * @return  bool
+     * A range of elements in a destination list to replace with a range of elements from a source list.
      */
-    static bool IsPropertyInForceSyncList(UProperty* upropPtr);
+    struct ListHunk
+    {
+    public:
+        int DestIndex;
+        int DestCount;
+        int SrcIndex;
+        int SrcCount;
+    };
 
     /**
-     * Called when a property is changed through the details panel.
-     *
-     * @param   UObject* uobjPtr whose property changed.
-     * @param   FPropertyChangedEvent& ev with information on what property changed.
+     * Content hashes of an object's top-level properties, computed from the uproperty memory when the properties were
+     * last synced.
      */
-    static void OnUPropertyChange(UObject* uobjPtr, FPropertyChangedEvent& ev);
+    struct ContentHashes
+    {
+    public:
+        /**
+         * Dictionary the properties were synced to. The hashes are discarded if the object is synced to a different
+         * dictionary.
+         */
+        const sfDictionaryProperty* DictPtr;
+
+        /**
+         * Keys are top-level uproperties and values are content hashes.
+         */
+        TMap<UProperty*, uint64_t> Hashes;
+    };
 
     /**
-     * Gets a double property value using reflection converted to an sfProperty.
-     *
-     * @param   const sfUPropertyInstance& upropInstance to get.
+     * A resolved step in a property path, cached so resolving sfProperty paths to uproperties does not need to look up
+     * uproperties by name. Element indexes are not part of the path, so one node is shared by all elements of a
+     * container.
+     */
+    struct PathNode
+    {
+    public:
+        /**
+         * How a path continues through the node's uproperty.
+         */
+        enum Kinds
+        {
+            VALUE,// the path cannot continue
+            STRUCT,// continues with a field name
+            ARRAY,// continues with an element index
+            MAP,// continues with a pair index, then 0 for the key or 1 for the value
+            SET// continues with an element index
+        };
+
+        UProperty* Property;
+        Kinds Kind;
+        // Offset of the value from its containing object or struct. Only used for top-level properties and fields.
+        int32 Offset;
+        // Field nodes for structs. Fields that were not found have null properties.
+        std::unordered_map<sfName, std::unique_ptr<PathNode>> Fields;
+        // Element node for arrays and sets, or key node for maps
+        std::unique_ptr<PathNode> Element;
+        // Value node for maps
+        std::unique_ptr<PathNode> Value;
+    };
+
+    /**
+     * Cached path nodes for the top-level properties of a class.
+     */
+    struct PathCache
+    {
+    public:
+        /**
+         * Class the cache was built for. Used to detect if the class was destroyed and its address reused.
+         */
+        TWeakObjectPtr<UClass> Class;
+
+        /**
+         * Top-level property nodes by name. Properties that were not found have null properties.
+         */
+        std::unordered_map<sfName, std::unique_ptr<PathNode>> Roots;
+    };
+
+    /**
+     * The syncable properties of a class, resolved once per class so creating, applying and sending properties does
+     * not need to iterate and filter the class's properties using reflection for every object.
+     */
+    struct SyncPlan
+    {
+    public:
+        /**
+         * A syncable property and the data needed to sync it.
+         */
+        struct Entry
+        {
+        public:
+            UProperty* Property;
+            sfName Name;
+            FString NameString;
+            const TypeHandler* HandlerPtr;
+        };
+
+        /**
+         * Class the plan was built for. Used to detect if the class was destroyed and its address reused.
+         */
+        TWeakObjectPtr<UClass> Class;
+
+        /**
+         * Syncable properties with a type handler.
+         */
+        std::vector<Entry> Entries;
+
+        /**
+         * One flag per entry that is true if the entry is plain old data and can be compared to its default value
+         * with memcmp. Most fields of unmodified objects are found to be default by memcmp without calling the
+         * uproperty's comparison.
+         */
+        std::vector<bool> PlainOldData;
+
+        /**
+         * One flag per entry that is true if the entry can be sent in a property record. Properties that contain
+         * object references are never recorded since references and stand-ins are fixed up by property path.
+         */
+        std::vector<bool> Recordable;
+
+        /**
+         * Cached blacklist results. Keys are blacklist pointers and values have one flag per entry that is true if the
+         * entry is in the blacklist.
+         */
+        std::unordered_map<const TSet<FString>*, std::vector<bool>> BlacklistResults;
+    };
+
+    /**
+     * A schema this client published for a class. The schema lists the names and types of the class's recordable
+     * properties in sync plan order.
+     */
+    struct Schema
+    {
+    public:
+        /**
+         * Class the schema was built for. Used to detect if the class was destroyed and its address reused.
+         */
+        TWeakObjectPtr<UClass> Class;
+
+        /**
+         * Schema object.
+         */
+        sfObject::SPtr ObjectPtr;
+
+        /**
+         * Number of fields in the schema.
+         */
+        int NumFields;
+    };
+
+    /**
+     * Template values for objects of a class in the batch being created.
+     */
+    struct Template
+    {
+    public:
+        /**
+         * Template object.
+         */
+        sfObject::SPtr ObjectPtr;
+
+        /**
+         * Object the template value was taken from for each sync plan entry, or nullptr if the entry is not in the
+         * template.
+         */
+        std::vector<UObject*> Sources;
+    };
+
+    /**
+     * A schema from the server, resolved against a local class.
+     */
+    struct ResolvedSchema
+    {
+    public:
+        /**
+         * Class the schema was resolved for. Used to detect if the class was destroyed and its address reused.
+         */
+        TWeakObjectPtr<UClass> Class;
+
+        /**
+         * Sync plan entry index for each schema field, or -1 if the class has no syncable property with the field's
+         * name and type.
+         */
+        std::vector<int> Entries;
+
+        /**
+         * Schema field index for each sync plan entry, or -1 if the entry is not in the schema.
+         */
+        std::vector<int> Fields;
+    };
+
+    // Minimum number of objects of a class in a batch to create a template for
+    static const int MIN_TEMPLATE_OBJECTS = 4;
+
+    // Number of type tags. Tags are bit indexes of a UProperty class's own cast flag so there can be at most 64.
+    static const int NUM_TYPE_TAGS = 64;
+
+    // Number of bytes of elements per packed array slice. Slices have at least one element.
+    static const int PACKED_SLICE_BYTES = 1024;
+
+    // Maximum number of bytes of strings to cache string table ids for. The string cache is cleared when it is full.
+    static const int MAX_STRING_CACHE_BYTES = 8 * 1024 * 1024;
+
+    // Maximum number of inserted plus removed elements to search for when diffing lists. Lists with more changes are
+    // overwritten in place.
+    static const int MAX_LIST_DIFF_COST = 256;
+
+    // Indexes are type tags from GetTypeTag. Unsupported types have null handler functions.
+    static TypeHandler m_typeHandlers[NUM_TYPE_TAGS];
+    static bool m_initialized;
+    static TMap<FScriptMap*, TSharedPtr<FScriptMapHelper>> m_staleMaps;// maps that need rehashing
+    static TMap<FScriptSet*, TSharedPtr<FScriptSetHelper>> m_staleSets;// sets that need rehashing
+    // Sparse indexes of valid elements in maps and sets, in order. Keys are FScriptMap or FScriptSet pointers.
+    static TMap<const void*, TArray<int32>> m_sparseIndexes;
+    // properties changed by the server we need to fire events for, grouped by object. A nullptr property on an actor
+    // means one of its components changed.
+    static TMap<UObject*, TArray<UProperty*>> m_serverChangedProperties;
+    static ChangeEventStats m_changeEventStats;
+    // properties changed locally we need to process
+    // Values are true if all changes to the property this tick were interactive
+    static TMap<TPair<UObject*, UProperty*>, bool> m_localChangedProperties;
+    // Times until which interactive changes to recently sent properties are held back
+    static TMap<TPair<UObject*, UProperty*>, double> m_throttleTimes;
+    // Properties with held back changes to send when their throttle time ends
+    static TMap<TPair<UObject*, UProperty*>, TWeakObjectPtr<UObject>> m_deferredProperties;
+    static TMap<FName, float> m_classSyncIntervals;
+    static TMap<TPair<FName, FName>, float> m_propertySyncIntervals;// key: owner class name, property name
+    static ThrottleStats m_throttleStats;
+    // we don't call property change handlers on non-editable properties unless they're in the white list
+    static TSet<TPair<FName, FName>> m_forceSyncList;// key: owner class name, value: property name
+    static FDelegateHandle m_onPropertyChangeHandle;
+    static TMap<FName, PropertyChangeHandler> m_classNameToPropertyChangeHandler;
+    static TSet<FName> m_syncDefaultOnlyList;// Sync default only properties for types in this list
+    static TSet<FName> m_blittableStructs;// Struct types synced as raw bytes
+    static OnGetAssetPropertyEvent m_onGetAssetProperty;
+    static std::unordered_map<const UClass*, SyncPlan> m_syncPlans;
+    static std::unordered_map<const UClass*, PathCache> m_pathCaches;
+    static std::unordered_map<const UClass*, Schema> m_schemas;
+    static std::unordered_map<uint32_t, ResolvedSchema> m_resolvedSchemas;// key: schema object id
+    static std::unordered_map<const UClass*, Template> m_templates;
+    static std::vector<sfObject::SPtr> m_templateObjects;// template objects created by this client
+    static TSet<uint32_t> m_missingSchemas;// ids of schemas we warned about not finding
+    static TemplateStats m_templateStats;
+    // Last published schema version by class path. Versions increase when a class is republished, such as after a
+    // hot reload.
+    static TMap<FString, int> m_schemaVersions;
+    // Scene component transform properties that can be sent with quantized encodings
+    static UProperty* m_locationPropPtr;
+    static UProperty* m_rotationPropPtr;
+    static UProperty* m_scalePropPtr;
+    // Default subobjects by outer class and name. Null values mean the outer class has no default subobject with that
+    // name.
+    static TMap<TPair<UClass*, FName>, TWeakObjectPtr<UObject>> m_defaultSubobjects;
+    static ListDiffStats m_listDiffStats;
+    // Hashes of the last synced property values so unchanged properties can be skipped without creating sfProperties
+    static TMap<UObject*, ContentHashes> m_contentHashes;
+    static ContentHashStats m_contentHashStats;
+    // Cached string table ids and strings for the current session
+    static TMap<FString, uint32_t, FDefaultSetAllocator, CaseSensitiveStringKeyFuncs> m_stringIds;
+    // Keys are name display indexes in the high bits and name numbers in the low bits
+    static TMap<uint64, uint32_t> m_nameIds;
+    static TMap<uint32_t, FString> m_idStrings;
+    static int m_stringCacheBytes;
+
+    /**
+     * Registers UProperty type handlers.
+     */
+    static void Initialize();
+
+    /**
+     * Gets the string for a session string table id. Strings are cached until disconnecting.
+     *
+     * @param   uint32_t id
+     * @return  FString
+     */
+    static FString GetStringFromTable(uint32_t id);
+
+    /**
+     * Adds a string and its string table id to the string cache. Clears the cache first if adding the string would
+     * exceed the memory cap.
+     *
+     * @param   const FString& value
+     * @param   uint32_t id
+     */
+    static void CacheString(const FString& value, uint32_t id);
+
+    /**
+     * Clears the cached strings and string table ids.
+     */
+    static void ClearStringCache();
+
+    /**
+     * Creates a property type handler.
+     *
+     * @param   UClass* typePtr to create handler for.
+     * @param   TypeHandler::Getter getter for getting properties of the given type.
+     * @param   TypeHandler::Setter setter for setting properties of the given type.
+     */
+    static void CreateTypeHandler(UClass* typePtr, TypeHandler::Getter getter, TypeHandler::Setter setter);
+
+    /**
+     * Gets the type tag for a UProperty class. The tag is the bit index of the cast flag the class adds to its super
+     * class's cast flags, which is unique for each engine UProperty class. This lets us find a type handler with an
+     * array lookup instead of hashing.
+     *
+     * @param   UClass* typePtr to get tag for.
+     * @return  int type tag, or -1 if the class does not add exactly one cast flag.
+     */
+    static int GetTypeTag(UClass* typePtr)
+    {
+        UClass* superPtr = typePtr->GetSuperClass();
+        uint64 flags = (uint64)typePtr->ClassCastFlags;
+        if (superPtr != nullptr)
+        {
+            flags &= ~(uint64)superPtr->ClassCastFlags;
+        }
+        if (flags == 0 || (flags & (flags - 1)) != 0)
+        {
+            return -1;
+        }
+        return (int)FMath::FloorLog2_64(flags);
+    }
+
+    /**
+     * Gets the type handler for a UProperty.
+     *
+     * @param   UProperty* upropPtr to get handler for.
+     * @return  const TypeHandler* handler, or nullptr if the property type is not supported.
+     */
+    static const TypeHandler* GetTypeHandler(UProperty* upropPtr)
+    {
+        if (!m_initialized)
+        {
+            Initialize();
+        }
+        int tag = GetTypeTag(upropPtr->GetClass());
+        return tag < 0 || m_typeHandlers[tag].Get == nullptr ? nullptr : &m_typeHandlers[tag];
+    }
+
+    /**
+     * Gets the sync plan for a class, building it if it does not exist or is stale.
+     *
+     * @param   UClass* classPtr to get sync plan for.
+     * @return  SyncPlan&
+     */
+    static SyncPlan& GetSyncPlan(UClass* classPtr);
+
+    /**
+     * Gets the blacklist flags for a sync plan, computing them if they are not cached. The blacklist must not be
+     * modified after it is first used, since results are cached by pointer.
+     *
+     * @param   SyncPlan& plan to get blacklist flags for.
+     * @param   const TSet<FString>* const blacklistPtr
+     * @return  const std::vector<bool>* flags that are true for blacklisted entries, or nullptr if blacklistPtr is
+     *          nullptr.
+     */
+    static const std::vector<bool>* GetBlacklistFlags(SyncPlan& plan, const TSet<FString>* const blacklistPtr);
+
+    /**
+     * Checks if a property can be sent in a property record. Properties that are or contain object references
+     * cannot.
+     *
+     * @param   UProperty* upropPtr to check.
+     * @return  bool
+     */
+    static bool IsRecordable(UProperty* upropPtr);
+
+    /**
+     * Gets the schema for a class, creating the schema object if this client has not published one for the class.
+     *
+     * @param   UClass* classPtr to get schema for.
+     * @param   SyncPlan& plan for the class.
+     * @return  const Schema* schema, or nullptr if there is no session.
+     */
+    static const Schema* GetSchema(UClass* classPtr, SyncPlan& plan);
+
+    /**
+     * Resolves the schema a property record refers to against a class.
+     *
+     * @param   UClass* classPtr to resolve the schema for.
+     * @param   SyncPlan& plan for the class.
+     * @param   sfListProperty::SPtr recordPtr
+     * @return  const ResolvedSchema* resolved schema, or nullptr if the record is invalid.
+     */
+    static const ResolvedSchema* ResolveSchema(UClass* classPtr, SyncPlan& plan, sfListProperty::SPtr recordPtr);
+
+    /**
+     * Reads the values from the property record in a dictionary into the values for each sync plan entry. Entries not
+     * in the record are not changed.
+     *
+     * @param   UClass* classPtr the record is for.
+     * @param   SyncPlan& plan for the class.
+     * @param   sfDictionaryProperty::SPtr dictPtr to get the record from.
+     * @param   std::vector<sfProperty::SPtr>& values to read into. Has one value per plan entry.
+     * @return  bool false if the dictionary has no valid record.
+     */
+    static bool ReadRecord(
+        UClass* classPtr,
+        SyncPlan& plan,
+        sfDictionaryProperty::SPtr dictPtr,
+        std::vector<sfProperty::SPtr>& values);
+
+    /**
+     * Reads the value for one sync plan entry from the property record in a dictionary.
+     *
+     * @param   UClass* classPtr the record is for.
+     * @param   SyncPlan& plan for the class.
+     * @param   sfDictionaryProperty::SPtr dictPtr to get the record from.
+     * @param   int entry - sync plan entry index.
+     * @return  sfProperty::SPtr value, or nullptr if the record does not have the entry.
+     */
+    static sfProperty::SPtr ReadRecordValue(
+        UClass* classPtr,
+        SyncPlan& plan,
+        sfDictionaryProperty::SPtr dictPtr,
+        int entry);
+
+    /**
+     * Gets the properties of the template a dictionary refers to.
+     *
+     * @param   UObject* uobjPtr the dictionary belongs to.
+     * @param   sfDictionaryProperty::SPtr dictPtr
+     * @return  sfDictionaryProperty::SPtr template properties, or nullptr if the dictionary does not refer to a
+     *          template or the template was not found.
+     */
+    static sfDictionaryProperty::SPtr FindTemplate(UObject* uobjPtr, sfDictionaryProperty::SPtr dictPtr);
+
+    /**
+     * Gets the values from the property record in a dictionary and the template it refers to for each sync plan
+     * entry. Values in the record override values in the template.
+     *
+     * @param   UObject* uobjPtr the dictionary belongs to.
+     * @param   SyncPlan& plan for the object's class.
+     * @param   sfDictionaryProperty::SPtr dictPtr to get the record from.
+     * @param   std::vector<sfProperty::SPtr>& values - set to one value per plan entry. Values are nullptr for entries
+     *          not in the record or template.
+     * @return  bool false if the dictionary has no valid record or template.
+     */
+    static bool GetRecordValues(
+        UObject* uobjPtr,
+        SyncPlan& plan,
+        sfDictionaryProperty::SPtr dictPtr,
+        std::vector<sfProperty::SPtr>& values);
+
+    /**
+     * Gets the value for a property from the property record in a dictionary or the template it refers to.
+     *
+     * @param   UObject* uobjPtr the dictionary belongs to.
+     * @param   UProperty* upropPtr to get the value for.
+     * @param   sfDictionaryProperty::SPtr dictPtr to get the record from.
+     * @return  sfProperty::SPtr value, or nullptr if the record and template do not have the property.
+     */
+    static sfProperty::SPtr GetRecordValue(UObject* uobjPtr, UProperty* upropPtr, sfDictionaryProperty::SPtr dictPtr);
+
+    /**
+     * Checks if a property is syncable on objects of the given class.
+     *
+     * @param   UClass* classPtr to check.
+     * @param   UProperty* upropPtr to check.
+     * @return  bool true if the property is syncable.
+     */
+    static bool IsSyncableForClass(UClass* classPtr, UProperty* upropPtr);
+
+    /**
+     * Returns true if the given UProperty is in the force to sync list.
+     *
+     * @param   UObject* uobjPtr to check
+     * @param   UProperty* upropPtr to check
+     * @return  bool
+     */
+    static bool IsPropertyInForceSyncList(UProperty* upropPtr);
+
+    /**
+     * Gets the minimum number of seconds between sending interactive changes to a property.
+     *
+     * @param   UClass* classPtr of the object the property belongs to.
+     * @param   UProperty* upropPtr
+     * @return  float
+     */
+    static float GetSyncInterval(UClass* classPtr, UProperty* upropPtr);
+
+    /**
+     * Calls PostEditChangeProperty on an actor for each of its changed properties. For blueprint actors, every call
+     * but the last is interactive so the construction script only runs once.
+     *
+     * @param   AActor* actorPtr
+     * @param   TArray<UProperty*>& properties that changed. nullptr means a component changed.
+     */
+    static void BroadcastActorChangeEvents(AActor* actorPtr, TArray<UProperty*>& properties);
+
+    /**
+     * Called when a property is changed through the details panel.
+     *
+     * @param   UObject* uobjPtr whose property changed.
+     * @param   FPropertyChangedEvent& ev with information on what property changed.
+     */
+    static void OnUPropertyChange(UObject* uobjPtr, FPropertyChangedEvent& ev);
+
+    /**
+     * Gets a double property value using reflection converted to an sfProperty.
+     *
+     * @param   const sfUPropertyInstance& upropInstance to get.
      * @return  sfProperty::SPtr
      */
     static sfProperty::SPtr GetDouble(const sfUPropertyInstance& upropInstance);
@@ -624,6 +1489,25 @@ private:
      */
     static bool SetStruct(const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr);
 
+    /**
+     * Gets the quantized encoding for a scene component location, rotation or scale.
+     *
+     * @param   const sfUPropertyInstance& upropInstance to get.
+     * @return  sfValueProperty::SPtr quantized value, or nullptr if the uproperty is not a scene component transform
+     *          property or the value cannot be quantized.
+     */
+    static sfValueProperty::SPtr GetQuantizedTransform(const sfUPropertyInstance& upropInstance);
+
+    /**
+     * Decodes a quantized scene component location, rotation or scale.
+     *
+     * @param   UProperty* upropPtr the value is for.
+     * @param   const ksMultiType& value to decode.
+     * @param   void* resultPtr to write the decoded struct to.
+     * @return  bool false if the uproperty is not a scene component transform property or the value is not quantized.
+     */
+    static bool DecodeQuantizedTransform(UProperty* upropPtr, const ksMultiType& value, void* resultPtr);
+
     /**
      * Gets an object property value from an object using reflection converted to an sfProperty.
      *
@@ -704,66 +1588,130 @@ private:
     static bool SetSoftClass(const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr);
 
     /**
-     * Takes a pointer to a struct and sets it to point at a field of the struct using reflection. Returns false if the
-     * uproperty is not a struct property.
+     * Copies the fields of a plain-old-data struct. Padding bytes between fields are not copied, so they keep the
+     * destination's values.
      *
-     * @param   const sfName& name of field to get.
-     * @param   UProperty*& upropPtr - if not a struct property, returns false. Otherwise this is updated to point to
-     *          the field property. If the field is not found, this is set to nullptr.
-     * @param   void*& ptr to the struct data. Will be updated to point to the field data, if found.
-     * @return  bool true if upropPtr is a struct property.
+     * @param   UStruct* structPtr - struct type.
+     * @param   const void* srcPtr - struct to copy from.
+     * @param   uint8_t* destPtr - struct to copy to.
      */
-    static bool GetStructField(const sfName& name, UProperty*& upropPtr, void*& ptr);
+    static void CopyStructWithoutPadding(UStruct* structPtr, const void* srcPtr, uint8_t* destPtr);
 
     /**
-     * Takes a pointer to an array and sets it to point at an element of the array using reflection. Returns false if
-     * the uproperty is not an array property.
+     * Gets a packed array value from an array of numbers or blittable structs. The array is split into typed array
+     * slices with a fixed number of elements so a change to a range of elements only changes the slices in that range.
      *
-     * @param   index of element to get.
-     * @param   UProperty*& upropPtr - if not an array property, returns false. Otherwise this is updated to point to
-     *          the element property. If the element is not found, this is set to nullptr.
-     * @param   void*& ptr to the array data. Will be updated to point to the element data, if found.
-     * @return  bool true if upropPtr is an array property.
+     * @param   UArrayProperty* arrayPropPtr
+     * @param   FScriptArrayHelper& array to pack.
+     * @return  sfProperty::SPtr list of slices.
      */
-    static bool GetArrayElement(int index, UProperty*& upropPtr, void*& ptr);
+    static sfProperty::SPtr GetPackedArray(UArrayProperty* arrayPropPtr, FScriptArrayHelper& array);
 
     /**
-     * Takes a pointer to a map and sets it to point at a key or value of the map using reflection. Returns false if
-     * the uproperty is not a map property.
+     * Sets the range of array elements for a packed slice.
      *
-     * @param   index of element to get.
-     * @param   UProperty*& upropPtr - if not a map property, returns false. Otherwise this is updated to point to the
-     *          element property. If the element is not found, this is set to nullptr.
-     * @param   void*& ptr to the map data. Will be updated to point to the element data, if found.
-     * @param   TSharedPtr<FScriptMapHelper> outMapPtr - will point to the map if the element we are getting is a key.
-     * @param   std::stack<sfProperty::SPtr>& propertyStack containing the sub properties to look for next. If the
-     *          uproperty is a map and the index is within its bounds, the top property will be popped off the stack.
-     *          If it's index is 0, we'll get the key, If 1, we'll get the value.
-     * @return  bool true if upropPtr is a map property.
+     * @param   UArrayProperty* arrayPropPtr
+     * @param   FScriptArrayHelper& array to set.
+     * @param   sfProperty::SPtr slicePtr
+     * @return  bool true if the array changed.
      */
-    static bool GetMapElement(
-        int index,
-        UProperty*& upropPtr,
-        void*& ptr,
-        TSharedPtr<FScriptMapHelper>& outMapPtr,
-        std::stack<sfProperty::SPtr>& propertyStack);
+    static bool SetPackedSlice(UArrayProperty* arrayPropPtr, FScriptArrayHelper& array, sfProperty::SPtr slicePtr);
 
     /**
-     * Takes a pointer to a set and sets it to point at an element of the set using reflection. Returns false if the
-     * uproperty is not a set property.
+     * Gets the typed array type packed slices use for an element property. Floats, ints, uint32s and int64s use the
+     * matching typed array. Other numbers and structs use byte arrays.
      *
-     * @param   index of element to get.
-     * @param   UProperty*& upropPtr - if not a set property, returns false. Otherwise this is updated to point to the
-     *          element property. If the element is not found, this is set to nullptr.
-     * @param   void*& ptr to the set data. Will be updated to point to the element data, if found.
-     * @param   TSharedPtr<FScriptMapHelper> outSetPtr - will point to the set.
-     * @return  bool true if upropPtr is a map property.
+     * @param   UProperty* upropPtr - element property.
+     * @return  uint8_t ksMultiType array type, or ksMultiType::UNDEFINED if the element property can't be packed.
      */
-    static bool GetSetElement(
-        int index,
-        UProperty*& upropPtr,
-        void*& ptr,
-        TSharedPtr<FScriptSetHelper>& outSetPtr);
+    static uint8_t GetPackedType(UProperty* upropPtr);
+
+    /**
+     * Gets the number of elements in a full packed slice.
+     *
+     * @param   UProperty* upropPtr - element property.
+     * @return  int number of elements per slice.
+     */
+    static int GetPackedSliceCapacity(UProperty* upropPtr);
+
+    /**
+     * Gets the number of elements in a packed slice.
+     *
+     * @param   uint8_t packedType - expected ksMultiType array type.
+     * @param   int elementSize in bytes.
+     * @param   sfProperty::SPtr slicePtr
+     * @return  int number of elements, or -1 if the property is not a slice of the expected type.
+     */
+    static int GetPackedSliceLength(uint8_t packedType, int elementSize, sfProperty::SPtr slicePtr);
+
+    /**
+     * Copies the elements in a packed slice into an array.
+     *
+     * @param   sfProperty::SPtr slicePtr to copy.
+     * @param   FScriptArrayHelper& array to copy into. Must have room for the slice at the element index.
+     * @param   int elementIndex to copy to.
+     * @param   int elementSize in bytes.
+     * @return  bool true if the array changed.
+     */
+    static bool CopySlice(sfProperty::SPtr slicePtr, FScriptArrayHelper& array, int elementIndex, int elementSize);
+
+    /**
+     * Gets the cached path node for a top-level property of a class, creating it if it is not cached.
+     *
+     * @param   UClass* classPtr to get property from.
+     * @param   const sfName& name of the property.
+     * @return  PathNode* node for the property, or nullptr if the class does not have the property.
+     */
+    static PathNode* GetRootPathNode(UClass* classPtr, const sfName& name);
+
+    /**
+     * Gets the cached path node for a field of a struct node, creating it if it is not cached.
+     *
+     * @param   PathNode& node - struct node to get field from.
+     * @param   const sfName& name of the field.
+     * @return  PathNode* node for the field, or nullptr if the struct does not have the field.
+     */
+    static PathNode* GetFieldPathNode(PathNode& node, const sfName& name);
+
+    /**
+     * Gets a child path node, creating it if it does not exist.
+     *
+     * @param   std::unique_ptr<PathNode>& childPtr - slot for the child node.
+     * @param   UProperty* upropPtr for the child if it needs to be created.
+     * @return  PathNode* child node, or nullptr if the child has no uproperty.
+     */
+    static PathNode* GetChildPathNode(std::unique_ptr<PathNode>& childPtr, UProperty* upropPtr);
+
+    /**
+     * Finds the sparse index of the nth valid element in a map or set. Builds and caches the sparse indexes of all
+     * elements in the container if they are not cached.
+     *
+     * @param   const Helper& helper - FScriptMapHelper or FScriptSetHelper for the container.
+     * @param   const void* containerPtr - FScriptMap or FScriptSet the helper is for.
+     * @param   int index of the element, counting only valid elements.
+     * @return  int sparse index, or -1 if the index is out of bounds.
+     */
+    template<typename Helper>
+    static int FindSparseIndex(const Helper& helper, const void* containerPtr, int index)
+    {
+        if (index < 0 || index >= helper.Num())
+        {
+            return -1;
+        }
+        TArray<int32>& sparseIndexes = m_sparseIndexes.FindOrAdd(containerPtr);
+        if (sparseIndexes.Num() != helper.Num())
+        {
+            sparseIndexes.Reset(helper.Num());
+            for (int i = 0; i < helper.GetMaxIndex(); i++)
+            {
+                if (helper.IsValidIndex(i))
+                {
+                    sparseIndexes.Add(i);
+                }
+            }
+        }
+        return sparseIndexes[index];
+    }
 
     /**
      * Gets the default object for an object.
@@ -773,6 +1721,33 @@ private:
      */
     static UObject* GetDefaultObject(UObject* uobjPtr);
 
+    /**
+     * Checks if a uproperty has the same value on two objects. Plain old data values are compared with memcmp first,
+     * falling back to the uproperty's comparison if the bytes differ. Every element of static arrays is compared.
+     *
+     * @param   UProperty* upropPtr to compare.
+     * @param   bool plainOldData - true if the uproperty is plain old data.
+     * @param   UObject* uobjPtr
+     * @param   UObject* otherPtr
+     * @return  bool true if the values are identical.
+     */
+    static bool IsIdentical(UProperty* upropPtr, bool plainOldData, UObject* uobjPtr, UObject* otherPtr)
+    {
+        if (plainOldData && FMemory::Memcmp(upropPtr->ContainerPtrToValuePtr<void>(uobjPtr),
+            upropPtr->ContainerPtrToValuePtr<void>(otherPtr), upropPtr->ElementSize * upropPtr->ArrayDim) == 0)
+        {
+            return true;
+        }
+        for (int i = 0; i < upropPtr->ArrayDim; i++)
+        {
+            if (!upropPtr->Identical_InContainer(uobjPtr, otherPtr, i))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     /**
      * Adds, removes, and/or sets elements in a destination list to make it the same as a source list.
      *
@@ -781,6 +1756,102 @@ private:
      */
     static void CopyList(sfListProperty::SPtr destPtr, sfListProperty::SPtr srcPtr);
 
+    /**
+     * Finds the ranges of elements that differ between two lists using Myers' diff algorithm on element hashes.
+     * Returns a single hunk covering everything between the common prefix and suffix if the edit script costs more
+     * than MAX_LIST_DIFF_COST.
+     *
+     * @param   sfListProperty::SPtr destPtr
+     * @param   sfListProperty::SPtr srcPtr
+     * @param   std::vector<ListHunk>& hunks - ranges that differ, in ascending order.
+     */
+    static void FindListHunks(sfListProperty::SPtr destPtr, sfListProperty::SPtr srcPtr, std::vector<ListHunk>& hunks);
+
+    /**
+     * Computes a hash of a property and its descendants. Equal properties have equal hashes.
+     *
+     * @param   sfProperty::SPtr propPtr
+     * @return  uint64_t
+     */
+    static uint64_t HashProperty(sfProperty::SPtr propPtr);
+
+    /**
+     * Computes a hash of a top-level uproperty value directly from the uproperty memory, without creating an
+     * sfProperty. Equal values have equal hashes.
+     *
+     * @param   UObject* uobjPtr the property belongs to.
+     * @param   UProperty* upropPtr to hash.
+     * @return  uint64_t hash, or 0 if the value cannot be hashed and must always be synced.
+     */
+    static uint64_t GetContentHash(UObject* uobjPtr, UProperty* upropPtr);
+
+    /**
+     * Combines a uproperty value into a content hash.
+     *
+     * @param   UProperty* upropPtr to hash.
+     * @param   void* dataPtr - pointer to the value.
+     * @param   uint64_t& hash to combine the value into.
+     * @return  bool false if the value cannot be hashed.
+     */
+    static bool HashUPropertyValue(UProperty* upropPtr, void* dataPtr, uint64_t& hash);
+
+    /**
+     * Combines an object reference into a content hash. References are hashed by address and sfObject id, since a
+     * reference to a level object is synced as a reference to its sfObject.
+     *
+     * @param   UObject* referencePtr
+     * @param   uint64_t& hash to combine the reference into.
+     * @return  bool false if the reference cannot be hashed because getting its value has side effects, which
+     *          happens for deleted objects and stand-ins for missing assets.
+     */
+    static bool HashObjectReference(UObject* referencePtr, uint64_t& hash);
+
+    /**
+     * Combines bytes into a content hash.
+     *
+     * @param   const void* dataPtr - pointer to the bytes.
+     * @param   int size - number of bytes.
+     * @param   uint64_t& hash to combine the bytes into.
+     */
+    static void HashBytes(const void* dataPtr, int size, uint64_t& hash)
+    {
+        const uint8_t* bytesPtr = (const uint8_t*)dataPtr;
+        for (int i = 0; i < size; i++)
+        {
+            hash = (hash ^ bytesPtr[i]) * 1099511628211ull;
+        }
+    }
+
+    /**
+     * Checks if a property's content hash is the same as when it was last synced to the given dictionary. Updates the
+     * content hash stats.
+     *
+     * @param   UObject* uobjPtr the property belongs to.
+     * @param   sfDictionaryProperty::SPtr dictPtr the property is synced to.
+     * @param   UProperty* upropPtr to check.
+     * @param   uint64_t hash - current content hash of the property.
+     * @return  bool true if the value is unchanged and does not need to be synced.
+     */
+    static bool IsContentUnchanged(
+        UObject* uobjPtr,
+        sfDictionaryProperty::SPtr dictPtr,
+        UProperty* upropPtr,
+        uint64_t hash);
+
+    /**
+     * Stores the content hash of a property that was synced to the given dictionary. Does nothing if the hash is 0.
+     *
+     * @param   UObject* uobjPtr the property belongs to.
+     * @param   sfDictionaryProperty::SPtr dictPtr the property was synced to.
+     * @param   UProperty* upropPtr that was synced.
+     * @param   uint64_t hash - content hash of the synced value.
+     */
+    static void SetContentHash(
+        UObject* uobjPtr,
+        sfDictionaryProperty::SPtr dictPtr,
+        UProperty* upropPtr,
+        uint64_t hash);
+
     /**
      * Adds, removes, and/or sets fields in a destination dictionary so to make it the same as a source dictionary.
      *
@@ -820,29 +1891,79 @@ private:
         return *(reinterpret_cast<const T*>(valuePtr->GetValue().GetData().data()));
     }
 
+    /**
+     * Gets a property of type T using reflection converted to an sfProperty.
+     *
+     * @param   const sfUPropertyInstance& upropInstance to get.
+     * @return  sfProperty::SPtr
+     */
+    template<typename T>
+    static sfProperty::SPtr GetNumeric(const sfUPropertyInstance& upropInstance)
+    {
+        // The type tag guarantees the property is a T, so we don't need Cast
+        T* tPtr = static_cast<T*>(upropInstance.Property());
+        return sfValueProperty::Create(tPtr->GetPropertyValue(upropInstance.Data()));
+    }
+
+    /**
+     * Sets a property of type T using reflection.
+     *
+     * @param   const sfUPropertyInstance& upropInstance to set.
+     * @param   sfProperty::SPtr propPtr to get value from.
+     * @return  bool true if the value changed.
+     */
+    template<typename T>
+    static bool SetNumeric(const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
+    {
+        T* tPtr = static_cast<T*>(upropInstance.Property());
+        if (!propPtr->Equals(sfValueProperty::Create(tPtr->GetPropertyValue(upropInstance.Data()))))
+        {
+            tPtr->SetPropertyValue(upropInstance.Data(), propPtr->AsValue()->GetValue());
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Gets a property of type T using reflection cast to U and converted to an sfProperty.
+     *
+     * @param   const sfUPropertyInstance& upropInstance to get.
+     * @return  sfProperty::SPtr
+     */
+    template<typename T, typename U>
+    static sfProperty::SPtr GetCastNumeric(const sfUPropertyInstance& upropInstance)
+    {
+        T* tPtr = static_cast<T*>(upropInstance.Property());
+        return sfValueProperty::Create((U)tPtr->GetPropertyValue(upropInstance.Data()));
+    }
+
+    /**
+     * Sets a property of type T using reflection from a U value.
+     *
+     * @param   const sfUPropertyInstance& upropInstance to set.
+     * @param   sfProperty::SPtr propPtr to get value from.
+     * @return  bool true if the value changed.
+     */
+    template<typename T, typename U>
+    static bool SetCastNumeric(const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
+    {
+        T* tPtr = static_cast<T*>(upropInstance.Property());
+        U value = propPtr->AsValue()->GetValue();
+        if ((U)tPtr->GetPropertyValue(upropInstance.Data()) != value)
+        {
+            tPtr->SetPropertyValue(upropInstance.Data(), value);
+            return true;
+        }
+        return false;
+    }
+
     /**
      * Creates a property handler for type T.
      */
     template<typename T>
     static void CreateTypeHandler()
     {
-        CreateTypeHandler(T::StaticClass(),
-            [](const sfUPropertyInstance& upropInstance)
-            {
-                T* tPtr = Cast<T>(upropInstance.Property());
-                return sfValueProperty::Create(tPtr->GetPropertyValue(upropInstance.Data()));
-            },
-            [](const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
-            {
-                T* tPtr = Cast<T>(upropInstance.Property());
-                if (!propPtr->Equals(sfValueProperty::Create(tPtr->GetPropertyValue(upropInstance.Data()))))
-                {
-                    tPtr->SetPropertyValue(upropInstance.Data(), propPtr->AsValue()->GetValue());
-                    return true;
-                }
-                return false;
-            }
-        );
+        CreateTypeHandler(T::StaticClass(), &GetNumeric<T>, &SetNumeric<T>);
     }
 
     /**
@@ -851,23 +1972,6 @@ private:
     template<typename T, typename U>
     static void CreateTypeHandler()
     {
-        CreateTypeHandler(T::StaticClass(),
-            [](const sfUPropertyInstance& upropInstance)
-            {
-                T* tPtr = Cast<T>(upropInstance.Property());
-                return sfValueProperty::Create((U)tPtr->GetPropertyValue(upropInstance.Data()));
-            },
-            [](const sfUPropertyInstance& upropInstance, sfProperty::SPtr propPtr)
-            {
-                T* tPtr = Cast<T>(upropInstance.Property());
-                U value = propPtr->AsValue()->GetValue();
-                if ((U)tPtr->GetPropertyValue(upropInstance.Data()) != value)
-                {
-                    tPtr->SetPropertyValue(upropInstance.Data(), value);
-                    return true;
-                }
-                return false;
-            }
-        );
+        CreateTypeHandler(T::StaticClass(), &GetCastNumeric<T, U>, &SetCastNumeric<T, U>);
     }
 };
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "sfStandInCache.h"
+
+#include <Log.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Engine/AssetManager.h>
+
+#define LOG_CHANNEL "sfStandInCache"
+
+FString sfStandInCache::m_sessionKey;
+TMap<FString, sfStandInCache::Entry> sfStandInCache::m_entries;
+bool sfStandInCache::m_isDirty = false;
+
+void sfStandInCache::SetSession(const FString& sessionKey)
+{
+    m_sessionKey = FPaths::MakeValidFileName(sessionKey);
+}
+
+void sfStandInCache::Load()
+{
+    m_entries.Empty();
+    m_isDirty = false;
+    if (m_sessionKey.IsEmpty())
+    {
+        return;
+    }
+    TArray<FString> lines;
+    if (!FFileHelper::LoadFileToStringArray(lines, *Path()))
+    {
+        return;
+    }
+    // Each line is "path\tclass\tbounds" where bounds are six comma-separated floats or empty.
+    TArray<FString> fields;
+    TArray<FString> values;
+    for (const FString& line : lines)
+    {
+        if (line.ParseIntoArray(fields, TEXT("\t"), false) < 2)
+        {
+            continue;
+        }
+        Entry& entry = m_entries.Add(fields[0]);
+        entry.ClassName = fields[1];
+        if (fields.Num() > 2 && fields[2].ParseIntoArray(values, TEXT(",")) == 6)
+        {
+            entry.HasBounds = true;
+            entry.Bounds = FBox(
+                FVector(FCString::Atof(*values[0]), FCString::Atof(*values[1]), FCString::Atof(*values[2])),
+                FVector(FCString::Atof(*values[3]), FCString::Atof(*values[4]), FCString::Atof(*values[5])));
+        }
+    }
+    KS::Log::Debug("Loaded " + std::to_string(m_entries.Num()) + " cached stand-in(s).", LOG_CHANNEL);
+}
+
+void sfStandInCache::Save()
+{
+    if (m_isDirty && !m_sessionKey.IsEmpty())
+    {
+        TArray<FString> lines;
+        for (const TPair<FString, Entry>& pair : m_entries)
+        {
+            FString line = pair.Key + "\t" + pair.Value.ClassName + "\t";
+            if (pair.Value.HasBounds)
+            {
+                const FBox& bounds = pair.Value.Bounds;
+                line += FString::SanitizeFloat(bounds.Min.X) + "," + FString::SanitizeFloat(bounds.Min.Y) + "," +
+                    FString::SanitizeFloat(bounds.Min.Z) + "," + FString::SanitizeFloat(bounds.Max.X) + "," +
+                    FString::SanitizeFloat(bounds.Max.Y) + "," + FString::SanitizeFloat(bounds.Max.Z);
+            }
+            lines.Add(line);
+        }
+        if (!FFileHelper::SaveStringArrayToFile(lines, *Path()))
+        {
+            KS::Log::Warning("Could not save stand-in cache to " + std::string(TCHAR_TO_UTF8(*Path())) + ".",
+                LOG_CHANNEL);
+        }
+    }
+    m_entries.Empty();
+    m_isDirty = false;
+}
+
+bool sfStandInCache::IsMissing(const FString& path)
+{
+    if (!m_entries.Contains(path))
+    {
+        return false;
+    }
+    // The asset may have been added since it was cached, such as by syncing source control.
+    if (UAssetManager::Get().GetAssetRegistry().GetAssetByObjectPath(FName(*path)).IsValid())
+    {
+        Remove(path);
+        return false;
+    }
+    return true;
+}
+
+void sfStandInCache::AddMissing(const FString& path, const FString& className)
+{
+    Entry& entry = m_entries.FindOrAdd(path);
+    if (entry.ClassName != className)
+    {
+        entry.ClassName = className;
+        m_isDirty = true;
+    }
+}
+
+void sfStandInCache::Remove(const FString& path)
+{
+    if (m_entries.Remove(path) > 0)
+    {
+        m_isDirty = true;
+    }
+}
+
+bool sfStandInCache::TryGetBounds(const FString& path, FBox& bounds)
+{
+    Entry* entryPtr = m_entries.Find(path);
+    if (entryPtr == nullptr || !entryPtr->HasBounds)
+    {
+        return false;
+    }
+    bounds = entryPtr->Bounds;
+    return true;
+}
+
+void sfStandInCache::SetBounds(const FString& path, const FBox& bounds)
+{
+    Entry* entryPtr = m_entries.Find(path);
+    if (entryPtr == nullptr || (entryPtr->HasBounds && entryPtr->Bounds == bounds))
+    {
+        return;
+    }
+    entryPtr->HasBounds = true;
+    entryPtr->Bounds = bounds;
+    m_isDirty = true;
+}
+
+FString sfStandInCache::Path()
+{
+    return FPaths::ProjectSavedDir() + "SceneFusion/StandInCache/" + m_sessionKey + ".txt";
+}
+
+#undef LOG_CHANNEL
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+/**
+ * Persistent local cache of missing asset metadata for a session. Remembers which assets were missing and the bounds
+ * of missing meshes so that rejoining a session can create stand-ins without waiting for asset loads to fail or for
+ * the session's mesh bounds object. The cache is stored in the project's saved directory, one file per session.
+ */
+class sfStandInCache
+{
+public:
+    /**
+     * Sets the session to cache stand-in data for. Call this before joining a session.
+     *
+     * @param   const FString& sessionKey that identifies the session. Empty to disable the cache.
+     */
+    static void SetSession(const FString& sessionKey);
+
+    /**
+     * Loads the cache for the current session from disk.
+     */
+    static void Load();
+
+    /**
+     * Saves the cache to disk if it changed and clears it from memory.
+     */
+    static void Save();
+
+    /**
+     * Checks if an asset was missing the last time it was loaded in this session and still is not in the asset
+     * registry.
+     *
+     * @param   const FString& path to the asset.
+     * @return  bool true if the asset is known to be missing.
+     */
+    static bool IsMissing(const FString& path);
+
+    /**
+     * Records that an asset is missing.
+     *
+     * @param   const FString& path to the asset.
+     * @param   const FString& className of the asset.
+     */
+    static void AddMissing(const FString& path, const FString& className);
+
+    /**
+     * Removes an asset from the cache. Call this when the asset becomes available.
+     *
+     * @param   const FString& path to the asset.
+     */
+    static void Remove(const FString& path);
+
+    /**
+     * Gets the cached bounds of a missing mesh.
+     *
+     * @param   const FString& path to the mesh.
+     * @param   FBox& bounds set to the cached bounds if they were found.
+     * @return  bool true if bounds were found.
+     */
+    static bool TryGetBounds(const FString& path, FBox& bounds);
+
+    /**
+     * Caches the bounds of a missing mesh.
+     *
+     * @param   const FString& path to the mesh.
+     * @param   const FBox& bounds
+     */
+    static void SetBounds(const FString& path, const FBox& bounds);
+
+private:
+    /**
+     * Cached data for a missing asset.
+     */
+    struct Entry
+    {
+    public:
+        FString ClassName;
+        bool HasBounds = false;
+        FBox Bounds;
+    };
+
+    static FString m_sessionKey;
+    static TMap<FString, Entry> m_entries;// key: asset path
+    static bool m_isDirty;
+
+    /**
+     * Gets the path to the cache file for the current session.
+     *
+     * @return  FString
+     */
+    static FString Path();
+};
@@ -0,0 +1,267 @@
+#include "sfTransformCodec.h"
+#include "sfPropertyUtil.h"
+#include "sfConfig.h"
+
+#include <cmath>
+
+// Smallest-three components are in the range [-1/sqrt(2), 1/sqrt(2)]
+#define QUAT_COMPONENT_RANGE 0.707106781186547524
+// Components within this of the largest component are treated as ties when choosing which component to drop
+#define QUAT_TIE_TOLERANCE 0.0005f
+
+sfValueProperty::SPtr sfTransformCodec::EncodeLocation(const FVector& value, int precisionBits)
+{
+    precisionBits = FMath::Clamp(precisionBits, 0, 16);
+    const double maxStep = (double)((1 << (LOCATION_AXIS_BITS - 1)) - 1);
+    uint8_t bytes[LOCATION_BYTES];
+    bytes[0] = (uint8_t)precisionBits;
+    for (int i = 0; i < 3; i++)
+    {
+        // Steps are powers of two so decoded values are exact floats and re-encode to the same step.
+        double step = FMath::FloorToDouble(std::ldexp((double)value[i], precisionBits) + 0.5);
+        if (!(FMath::Abs(step) <= maxStep))
+        {
+            return nullptr;
+        }
+        uint32_t bits = (uint32_t)(int32_t)step;
+        bytes[1 + i * 3] = (uint8_t)bits;
+        bytes[2 + i * 3] = (uint8_t)(bits >> 8);
+        bytes[3 + i * 3] = (uint8_t)(bits >> 16);
+    }
+    return sfValueProperty::Create(ksMultiType(ksMultiType::BYTE_ARRAY, bytes, LOCATION_BYTES, LOCATION_BYTES));
+}
+
+sfValueProperty::SPtr sfTransformCodec::EncodeRotator(const FRotator& value)
+{
+    const int64_t half = (int64_t)1 << (ROTATOR_AXIS_BITS - 1);
+    const uint64_t mask = ((uint64_t)1 << ROTATOR_AXIS_BITS) - 1;
+    float angles[3] = { value.Pitch, value.Yaw, value.Roll };
+    uint64_t bits = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        if (!FMath::IsFinite(angles[i]))
+        {
+            return nullptr;
+        }
+        double step = FMath::FloorToDouble(
+            (double)FRotator::NormalizeAxis(angles[i]) * (half * 2) / 360.0 + 0.5);
+        // 180 degrees wraps to -180 degrees
+        int64_t angle = (int64_t)step >= half ? (int64_t)step - half * 2 : (int64_t)step;
+        bits |= ((uint64_t)angle & mask) << (i * ROTATOR_AXIS_BITS);
+    }
+    return CreateBytes(bits, ROTATOR_BYTES);
+}
+
+sfValueProperty::SPtr sfTransformCodec::EncodeQuat(const FQuat& value)
+{
+    if (!FMath::IsFinite(value.X) || !FMath::IsFinite(value.Y) || !FMath::IsFinite(value.Z) ||
+        !FMath::IsFinite(value.W) || value.SizeSquared() < SMALL_NUMBER)
+    {
+        return nullptr;
+    }
+    // The largest component is reconstructed from the other three, so a decoded quaternion can re-encode with a
+    // different largest component when two are nearly equal. Re-encode the decoded value until the bits are stable.
+    uint64_t bits = PackQuat(value.GetNormalized());
+    for (int i = 0; i < MAX_QUAT_ENCODE_PASSES; i++)
+    {
+        uint64_t decodedBits = PackQuat(UnpackQuat(bits));
+        if (decodedBits == bits)
+        {
+            return CreateBytes(bits, QUAT_BYTES);
+        }
+        bits = decodedBits;
+    }
+    return nullptr;
+}
+
+sfValueProperty::SPtr sfTransformCodec::EncodeScale(const FVector& value)
+{
+    if (value.X != value.Y || value.X != value.Z)
+    {
+        return nullptr;
+    }
+    return sfValueProperty::Create(value.X);
+}
+
+bool sfTransformCodec::DecodeLocation(const ksMultiType& value, FVector& result)
+{
+    const std::vector<uint8_t>& bytes = value.GetData();
+    if (bytes.size() != LOCATION_BYTES || bytes[0] > 16)
+    {
+        return false;
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        uint32_t bits = (uint32_t)ReadBits(bytes.data() + 1 + i * 3, 3);
+        // Sign extend the 24-bit value
+        int32_t step = (int32_t)(bits << (32 - LOCATION_AXIS_BITS)) >> (32 - LOCATION_AXIS_BITS);
+        result[i] = (float)std::ldexp((double)step, -(int)bytes[0]);
+    }
+    return true;
+}
+
+bool sfTransformCodec::DecodeRotator(const ksMultiType& value, FRotator& result)
+{
+    const std::vector<uint8_t>& bytes = value.GetData();
+    if (bytes.size() != ROTATOR_BYTES)
+    {
+        return false;
+    }
+    uint64_t bits = ReadBits(bytes.data(), ROTATOR_BYTES);
+    const int64_t half = (int64_t)1 << (ROTATOR_AXIS_BITS - 1);
+    const uint64_t mask = ((uint64_t)1 << ROTATOR_AXIS_BITS) - 1;
+    float angles[3];
+    for (int i = 0; i < 3; i++)
+    {
+        int64_t angle = (int64_t)((bits >> (i * ROTATOR_AXIS_BITS)) & mask);
+        if (angle >= half)
+        {
+            angle -= half * 2;
+        }
+        angles[i] = (float)(angle * 360.0 / (half * 2));
+    }
+    result = FRotator(angles[0], angles[1], angles[2]);
+    return true;
+}
+
+bool sfTransformCodec::DecodeQuat(const ksMultiType& value, FQuat& result)
+{
+    const std::vector<uint8_t>& bytes = value.GetData();
+    if (bytes.size() != QUAT_BYTES)
+    {
+        return false;
+    }
+    result = UnpackQuat(ReadBits(bytes.data(), QUAT_BYTES));
+    return true;
+}
+
+bool sfTransformCodec::DecodeScale(const ksMultiType& value, FVector& result)
+{
+    if (value.GetType() != ksMultiType::FLOAT)
+    {
+        return false;
+    }
+    result = FVector((float)value);
+    return true;
+}
+
+sfValueProperty::SPtr sfTransformCodec::FromLocation(const FVector& value)
+{
+    if (sfConfig::Get().QuantizeTransforms)
+    {
+        sfValueProperty::SPtr propPtr = EncodeLocation(value, sfConfig::Get().LocationPrecisionBits);
+        if (propPtr != nullptr)
+        {
+            return propPtr;
+        }
+    }
+    return sfPropertyUtil::FromVector(value);
+}
+
+FVector sfTransformCodec::ToLocation(sfProperty::SPtr propertyPtr)
+{
+    FVector location;
+    if (propertyPtr != nullptr && propertyPtr->Type() == sfProperty::VALUE &&
+        DecodeLocation(propertyPtr->AsValue()->GetValue(), location))
+    {
+        return location;
+    }
+    return sfPropertyUtil::ToVector(propertyPtr);
+}
+
+sfValueProperty::SPtr sfTransformCodec::FromQuat(const FQuat& value)
+{
+    if (sfConfig::Get().QuantizeTransforms)
+    {
+        sfValueProperty::SPtr propPtr = EncodeQuat(value);
+        if (propPtr != nullptr)
+        {
+            return propPtr;
+        }
+    }
+    return sfPropertyUtil::FromQuat(value);
+}
+
+FQuat sfTransformCodec::ToQuat(sfProperty::SPtr propertyPtr)
+{
+    FQuat quat;
+    if (propertyPtr != nullptr && propertyPtr->Type() == sfProperty::VALUE &&
+        DecodeQuat(propertyPtr->AsValue()->GetValue(), quat))
+    {
+        return quat;
+    }
+    return sfPropertyUtil::ToQuat(propertyPtr);
+}
+
+uint64_t sfTransformCodec::PackQuat(const FQuat& value)
+{
+    float components[4] = { value.X, value.Y, value.Z, value.W };
+    float max = FMath::Max(FMath::Max(FMath::Abs(value.X), FMath::Abs(value.Y)),
+        FMath::Max(FMath::Abs(value.Z), FMath::Abs(value.W)));
+    // Use the first component that is nearly the largest. Quantization error can reorder components that are nearly
+    // equal, such as in axis-aligned rotations, and this keeps the same index after decoding.
+    int largest = 0;
+    while (FMath::Abs(components[largest]) < max - QUAT_TIE_TOLERANCE)
+    {
+        largest++;
+    }
+    // q and -q are the same rotation. Flip the sign so the largest component is positive and can be reconstructed.
+    float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    const int maxStep = (1 << QUAT_COMPONENT_BITS) - 1;
+    uint64_t bits = (uint64_t)largest;
+    int shift = 2;
+    for (int i = 0; i < 4; i++)
+    {
+        if (i == largest)
+        {
+            continue;
+        }
+        double normalized = (components[i] * sign + QUAT_COMPONENT_RANGE) / (QUAT_COMPONENT_RANGE * 2);
+        int step = FMath::Clamp((int)FMath::FloorToDouble(normalized * maxStep + 0.5), 0, maxStep);
+        bits |= (uint64_t)step << shift;
+        shift += QUAT_COMPONENT_BITS;
+    }
+    return bits;
+}
+
+FQuat sfTransformCodec::UnpackQuat(uint64_t bits)
+{
+    const int maxStep = (1 << QUAT_COMPONENT_BITS) - 1;
+    int largest = (int)(bits & 3);
+    float components[4];
+    float sumSquares = 0.0f;
+    int shift = 2;
+    for (int i = 0; i < 4; i++)
+    {
+        if (i == largest)
+        {
+            continue;
+        }
+        int step = (int)((bits >> shift) & maxStep);
+        components[i] = (float)((double)step / maxStep * (QUAT_COMPONENT_RANGE * 2) - QUAT_COMPONENT_RANGE);
+        sumSquares += components[i] * components[i];
+        shift += QUAT_COMPONENT_BITS;
+    }
+    components[largest] = FMath::Sqrt(FMath::Max(0.0f, 1.0f - sumSquares));
+    return FQuat(components[0], components[1], components[2], components[3]);
+}
+
+sfValueProperty::SPtr sfTransformCodec::CreateBytes(uint64_t bits, int numBytes)
+{
+    uint8_t bytes[sizeof(uint64_t)];
+    for (int i = 0; i < numBytes; i++)
+    {
+        bytes[i] = (uint8_t)(bits >> (i * 8));
+    }
+    return sfValueProperty::Create(ksMultiType(ksMultiType::BYTE_ARRAY, bytes, numBytes, numBytes));
+}
+
+uint64_t sfTransformCodec::ReadBits(const uint8_t* bytes, int numBytes)
+{
+    uint64_t bits = 0;
+    for (int i = 0; i < numBytes; i++)
+    {
+        bits |= (uint64_t)bytes[i] << (i * 8);
+    }
+    return bits;
+}
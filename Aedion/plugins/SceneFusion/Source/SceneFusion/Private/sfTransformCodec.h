@@ -0,0 +1,169 @@
+#pragma once
+
+#include <sfValueProperty.h>
+#include <CoreMinimal.h>
+
+using namespace KS::SceneFusion2;
+
+/**
+ * Quantized wire encodings for locations, rotations and scales. Every quantized encoding has a different byte count
+ * than the raw struct it replaces, so decoders can tell quantized values from raw values and clients with
+ * quantization disabled can still read them. Decoding is bit-stable: re-encoding a decoded value produces the same
+ * bytes, so applying a server value never generates an echo update.
+ *
+ * Encodings:
+ *  - Location: 1 byte of precision bits followed by three 24-bit signed fixed-point offsets from the world origin
+ *    (10 bytes). Values out of range are not quantized.
+ *  - Rotator: three 20-bit signed angles packed in 8 bytes, with an error of at most 0.00018 degrees.
+ *  - Quat: smallest-three with a 2-bit index and three 15-bit components packed in 6 bytes, with an error of at most
+ *    about 0.005 degrees.
+ *  - Scale: a single float when the scale is uniform (4 bytes). Non-uniform scales are not quantized.
+ */
+class sfTransformCodec
+{
+public:
+    /**
+     * Encodes a location as fixed-point offsets from the world origin with a step of 2^-precisionBits units.
+     *
+     * @param   const FVector& value to encode.
+     * @param   int precisionBits - number of fractional bits. Higher values are more precise but have less range.
+     * @return  sfValueProperty::SPtr quantized location, or nullptr if the location is out of range.
+     */
+    static sfValueProperty::SPtr EncodeLocation(const FVector& value, int precisionBits);
+
+    /**
+     * Encodes a rotator as three 20-bit angles.
+     *
+     * @param   const FRotator& value to encode.
+     * @return  sfValueProperty::SPtr quantized rotator, or nullptr if the rotator is not finite.
+     */
+    static sfValueProperty::SPtr EncodeRotator(const FRotator& value);
+
+    /**
+     * Encodes a quaternion using smallest-three.
+     *
+     * @param   const FQuat& value to encode.
+     * @return  sfValueProperty::SPtr quantized quaternion, or nullptr if the quaternion could not be encoded.
+     */
+    static sfValueProperty::SPtr EncodeQuat(const FQuat& value);
+
+    /**
+     * Encodes a uniform scale as a single float.
+     *
+     * @param   const FVector& value to encode.
+     * @return  sfValueProperty::SPtr quantized scale, or nullptr if the scale is not uniform.
+     */
+    static sfValueProperty::SPtr EncodeScale(const FVector& value);
+
+    /**
+     * Decodes a quantized location.
+     *
+     * @param   const ksMultiType& value to decode.
+     * @param   FVector& result
+     * @return  bool false if the value is not a quantized location.
+     */
+    static bool DecodeLocation(const ksMultiType& value, FVector& result);
+
+    /**
+     * Decodes a quantized rotator.
+     *
+     * @param   const ksMultiType& value to decode.
+     * @param   FRotator& result
+     * @return  bool false if the value is not a quantized rotator.
+     */
+    static bool DecodeRotator(const ksMultiType& value, FRotator& result);
+
+    /**
+     * Decodes a quantized quaternion.
+     *
+     * @param   const ksMultiType& value to decode.
+     * @param   FQuat& result
+     * @return  bool false if the value is not a quantized quaternion.
+     */
+    static bool DecodeQuat(const ksMultiType& value, FQuat& result);
+
+    /**
+     * Decodes a quantized scale.
+     *
+     * @param   const ksMultiType& value to decode.
+     * @param   FVector& result
+     * @return  bool false if the value is not a quantized scale.
+     */
+    static bool DecodeScale(const ksMultiType& value, FVector& result);
+
+    /**
+     * Constructs a location property. The location is quantized if quantized transforms are enabled in the config.
+     *
+     * @param   const FVector& value
+     * @return  sfValueProperty::SPtr
+     */
+    static sfValueProperty::SPtr FromLocation(const FVector& value);
+
+    /**
+     * Converts a raw or quantized property to a location.
+     *
+     * @param   sfProperty::SPtr propertyPtr
+     * @return  FVector
+     */
+    static FVector ToLocation(sfProperty::SPtr propertyPtr);
+
+    /**
+     * Constructs a quat property. The quat is quantized if quantized transforms are enabled in the config.
+     *
+     * @param   const FQuat& value
+     * @return  sfValueProperty::SPtr
+     */
+    static sfValueProperty::SPtr FromQuat(const FQuat& value);
+
+    /**
+     * Converts a raw or quantized property to a quat.
+     *
+     * @param   sfProperty::SPtr propertyPtr
+     * @return  FQuat
+     */
+    static FQuat ToQuat(sfProperty::SPtr propertyPtr);
+
+private:
+    static const int LOCATION_BYTES = 10;
+    static const int LOCATION_AXIS_BITS = 24;
+    static const int ROTATOR_BYTES = 8;
+    static const int ROTATOR_AXIS_BITS = 20;
+    static const int QUAT_BYTES = 6;
+    static const int QUAT_COMPONENT_BITS = 15;
+    // Max number of times to re-encode a decoded quaternion when looking for a bit-stable encoding
+    static const int MAX_QUAT_ENCODE_PASSES = 3;
+
+    /**
+     * Packs a quaternion using smallest-three.
+     *
+     * @param   const FQuat& value to pack.
+     * @return  uint64_t packed bits.
+     */
+    static uint64_t PackQuat(const FQuat& value);
+
+    /**
+     * Unpacks a quaternion packed with smallest-three.
+     *
+     * @param   uint64_t bits to unpack.
+     * @return  FQuat
+     */
+    static FQuat UnpackQuat(uint64_t bits);
+
+    /**
+     * Creates a byte array property from the low bytes of a little-endian integer.
+     *
+     * @param   uint64_t bits
+     * @param   int numBytes
+     * @return  sfValueProperty::SPtr
+     */
+    static sfValueProperty::SPtr CreateBytes(uint64_t bits, int numBytes);
+
+    /**
+     * Reads a little-endian integer from bytes.
+     *
+     * @param   const uint8_t* bytes to read.
+     * @param   int numBytes
+     * @return  uint64_t
+     */
+    static uint64_t ReadBits(const uint8_t* bytes, int numBytes);
+};
@@ -42,6 +42,26 @@ public:
         }
     }
 
+    /**
+     * Visits the descendants of a hierarchy object depth first without allocating or copying shared pointers. Prefer
+     * this to ForEachDescendant and DescendantIter for objects with many descendants. The hierarchy must not be
+     * changed during the visit.
+     *
+     * @param   const std::shared_ptr<T>& rootPtr to visit the descendants of.
+     * @param   F&& callback taking a const std::shared_ptr<T>& and returning true to visit its children.
+     */
+    template<typename T, typename F>
+    static void VisitDescendants(const std::shared_ptr<T>& rootPtr, F&& callback)
+    {
+        for (const std::shared_ptr<T>& childPtr : rootPtr->Children())
+        {
+            if (callback(childPtr))
+            {
+                VisitDescendants(childPtr, callback);
+            }
+        }
+    }
+
     /**
      * Gets name or blueprint path for the given class.
      *